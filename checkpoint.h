@@ -0,0 +1,209 @@
+/**
+ * @file checkpoint.h
+ * @brief Сохранение и восстановление состояния генераторов для длительных прогонов.
+ *
+ * Состояние генератора по умолчанию — его объектное представление
+ * (memcpy тривиально копируемого объекта). Генератор может определить
+ * собственные state_size / save_state() / load_state(); так делает
+ * StdEngine, чей образ зависит от стандартной библиотеки.
+ *
+ * Состав сохраняемых байтов:
+ * - скалярные генераторы (generators.h) — только слова состояния: 4 байта
+ *   у LCG и XORShift32, 8 у MWC (перенос, состояние), 16 у PCG32
+ *   (состояние, прибавка), 16/32 у xoshiro128/256**;
+ * - генераторы с дорожками (simd_generators.h) — состояния всех дорожек,
+ *   буфер pending с ещё не выданными значениями последнего шага и
+ *   pending_pos, чтобы чередующийся поток next() продолжился точно, плюс
+ *   выравнивание объекта до 64 байт (192 байта у PCG32x8, 2112 у
+ *   XORShift32Sliced: 1 КБ битовых плоскостей и 1 КБ pending). Значения
+ *   байтов выравнивания не определены; размер одинаков в скалярной и
+ *   векторной сборке;
+ * - Philox4x32 и ChaCha — ключ, поток и позиция, а также кэш последнего
+ *   блока cache / cache_block, который избыточен (вычисляется заново по
+ *   позиции), но входит в образ (48 и 120 байт);
+ * - SFMT19937 — 624 слова состояния, индекс и выравнивание до 16 байт
+ *   (2512 байт);
+ * - StdEngine — значения текстового представления движка (operator<<)
+ *   как 32-битные слова с их числом в начале (2504 байта у std::mt19937).
+ *
+ * Образ объекта переносим только между сборками с той же раскладкой
+ * структур; размер состояния проверяется при чтении.
+ *
+ * Файл контрольной точки: заголовок (сигнатура, версия, имя генератора,
+ * размеры, контрольная сумма), состояние генератора и состояние прогона
+ * вызывающего кода. Запись идёт во временный файл, который затем
+ * переименовывается, поэтому прерванная запись не портит прежнюю точку.
+ */
+
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include <cerrno>
+#include <cstdint>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+
+/**
+ * @brief Генератор с собственной сериализацией состояния.
+ */
+template <class G>
+concept CustomCheckpoint = requires(const G &cg, G &g, void *out, const void *in) {
+    { G::state_size } -> std::convertible_to<size_t>;
+    cg.save_state(out);
+    g.load_state(in);
+};
+
+/**
+ * @brief Генератор, состояние которого можно сохранить и восстановить.
+ */
+template <class G>
+concept Checkpointable = CustomCheckpoint<G> || std::is_trivially_copyable_v<G>;
+
+/**
+ * @brief Размер сохранённого состояния генератора в байтах.
+ */
+template <Checkpointable G>
+constexpr size_t state_size() {
+    if constexpr (CustomCheckpoint<G>) return G::state_size;
+    else return sizeof(G);
+}
+
+/**
+ * @brief Запись состояния генератора в буфер размером state_size<G>().
+ */
+template <Checkpointable G>
+inline void save_state(const G &g, void *out) {
+    if constexpr (CustomCheckpoint<G>) g.save_state(out);
+    else memcpy(out, &g, sizeof(G));
+}
+
+/**
+ * @brief Восстановление состояния генератора из буфера, записанного save_state().
+ */
+template <Checkpointable G>
+inline void load_state(G &g, const void *in) {
+    if constexpr (CustomCheckpoint<G>) g.load_state(in);
+    else memcpy(&g, in, sizeof(G));
+}
+
+/**
+ * @brief Заголовок файла контрольной точки.
+ */
+struct CheckpointHeader {
+    char magic[4];          ///< Сигнатура "LW3C".
+    uint32_t version;       ///< Версия формата.
+    char name[32];          ///< Имя генератора.
+    uint64_t state_bytes;   ///< Размер состояния генератора.
+    uint64_t progress_bytes; ///< Размер состояния прогона.
+    uint64_t checksum;      ///< FNV-1a от состояния генератора и прогона.
+};
+
+/// Версия формата контрольной точки.
+inline constexpr uint32_t checkpoint_version = 1;
+
+/**
+ * @brief Хеш FNV-1a (64 бита), продолжающий значение h.
+ */
+inline uint64_t fnv1a(const void *data, size_t n, uint64_t h = 0xcbf29ce484222325ull) {
+    const unsigned char *p = (const unsigned char *)data;
+    for (size_t i = 0; i < n; ++i) h = (h ^ p[i]) * 0x100000001b3ull;
+    return h;
+}
+
+/**
+ * @brief Запись контрольной точки.
+ * @param path Путь к файлу.
+ * @param name Имя генератора (до 31 символа).
+ * @param state Состояние генератора.
+ * @param state_bytes Размер состояния генератора.
+ * @param progress Состояние прогона.
+ * @param progress_bytes Размер состояния прогона.
+ * @return true при успешной записи.
+ */
+inline bool save_checkpoint(const char *path, const char *name, const void *state, size_t state_bytes,
+                            const void *progress, size_t progress_bytes) {
+    CheckpointHeader h{};
+    memcpy(h.magic, "LW3C", 4);
+    h.version = checkpoint_version;
+    strncpy(h.name, name, sizeof(h.name) - 1);
+    h.state_bytes = state_bytes;
+    h.progress_bytes = progress_bytes;
+    h.checksum = fnv1a(progress, progress_bytes, fnv1a(state, state_bytes));
+
+    char tmp[4096];
+    snprintf(tmp, sizeof(tmp), "%s.tmp", path);
+    FILE *f = fopen(tmp, "wb");
+    if (!f) return false;
+    bool ok = fwrite(&h, sizeof(h), 1, f) == 1 && fwrite(state, 1, state_bytes, f) == state_bytes &&
+              fwrite(progress, 1, progress_bytes, f) == progress_bytes;
+    ok = fclose(f) == 0 && ok;
+    return ok && rename(tmp, path) == 0;
+}
+
+/**
+ * @brief Чтение контрольной точки.
+ *
+ * Точка принимается, только если совпадают сигнатура, версия, имя
+ * генератора, оба размера и контрольная сумма. Отсутствующий файл и
+ * отвергнутый (чужой генератор, другой формат, обрезанный или
+ * повреждённый) различаются через missing: существующий файл нельзя
+ * молча перезаписывать новым прогоном.
+ * @param path Путь к файлу.
+ * @param name Ожидаемое имя генератора.
+ * @param state Буфер для состояния генератора.
+ * @param state_bytes Ожидаемый размер состояния генератора.
+ * @param progress Буфер для состояния прогона.
+ * @param progress_bytes Ожидаемый размер состояния прогона.
+ * @param missing Если не nullptr, получает true, когда файла нет (ENOENT).
+ * @return true, если точка прочитана и проверена.
+ */
+inline bool load_checkpoint(const char *path, const char *name, void *state, size_t state_bytes, void *progress,
+                            size_t progress_bytes, bool *missing = nullptr) {
+    FILE *f = fopen(path, "rb");
+    if (missing) *missing = !f && errno == ENOENT;
+    if (!f) return false;
+    CheckpointHeader h;
+    std::unique_ptr<unsigned char[]> buf(new unsigned char[state_bytes + progress_bytes]);
+    bool ok = fread(&h, sizeof(h), 1, f) == 1 && memcmp(h.magic, "LW3C", 4) == 0 &&
+              h.version == checkpoint_version && strncmp(h.name, name, sizeof(h.name) - 1) == 0 &&
+              h.state_bytes == state_bytes && h.progress_bytes == progress_bytes &&
+              fread(buf.get(), 1, state_bytes + progress_bytes, f) == state_bytes + progress_bytes;
+    fclose(f);
+    if (!ok || h.checksum != fnv1a(buf.get() + state_bytes, progress_bytes, fnv1a(buf.get(), state_bytes)))
+        return false;
+    memcpy(state, buf.get(), state_bytes);
+    memcpy(progress, buf.get() + state_bytes, progress_bytes);
+    return true;
+}
+
+/**
+ * @brief Запись контрольной точки для генератора известного типа.
+ */
+template <Checkpointable G, class Progress>
+inline bool save_checkpoint(const char *path, const char *name, const G &g, const Progress &progress) {
+    static_assert(std::is_trivially_copyable_v<Progress>);
+    unsigned char state[state_size<G>()];
+    save_state(g, state);
+    return save_checkpoint(path, name, state, sizeof(state), &progress, sizeof(Progress));
+}
+
+/**
+ * @brief Чтение контрольной точки для генератора известного типа.
+ *
+ * При ошибке g и progress не изменяются.
+ */
+template <Checkpointable G, class Progress>
+inline bool load_checkpoint(const char *path, const char *name, G &g, Progress &progress, bool *missing = nullptr) {
+    static_assert(std::is_trivially_copyable_v<Progress>);
+    unsigned char state[state_size<G>()];
+    Progress p;
+    if (!load_checkpoint(path, name, state, sizeof(state), &p, sizeof(Progress), missing)) return false;
+    load_state(g, state);
+    progress = p;
+    return true;
+}
+
+#endif // CHECKPOINT_H
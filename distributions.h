@@ -0,0 +1,341 @@
+/**
+ * @file distributions.h
+ * @brief Нормальное и экспоненциальное распределения методом зиккурата поверх блочного fill().
+ *
+ * Таблицы зиккурата (Марсалья, Цанг, 2000) строятся при компиляции.
+ * Пакетные функции fill_normal() / fill_exponential() запрашивают у
+ * генератора блок 32-битных слов и обрабатывают общий случай (значение
+ * внутри прямоугольника слоя, ~99% слов) векторно. Слова, попавшие в клин
+ * или хвост, только запоминаются и дообрабатываются скалярно после блока,
+ * поэтому редкие медленные ветки не прерывают векторный цикл.
+ */
+
+#ifndef DISTRIBUTIONS_H
+#define DISTRIBUTIONS_H
+
+#include <cmath>
+#include <cstdint>
+#include <cstddef>
+
+#include "generators.h"
+
+/// Натуральный логарифм 2.
+inline constexpr double const_ln2 = 0.69314718055994530942;
+
+/**
+ * @brief Экспонента, вычисляемая при компиляции.
+ *
+ * x = k * ln 2 + r, |r| <= ln 2 / 2; e^r — ряд Тейлора, 2^k — умножениями.
+ */
+constexpr double const_exp(double x) {
+    int k = int(x / const_ln2 + (x < 0 ? -0.5 : 0.5));
+    double r = x - k * const_ln2;
+    double term = 1.0, sum = 1.0;
+    for (int i = 1; i < 30; ++i) {
+        term *= r / i;
+        sum += term;
+    }
+    for (; k > 0; --k) sum *= 2.0;
+    for (; k < 0; ++k) sum *= 0.5;
+    return sum;
+}
+
+/**
+ * @brief Натуральный логарифм (x > 0), вычисляемый при компиляции.
+ *
+ * x = m * 2^e, m из [1, 2); ln m = 2 * atanh((m - 1) / (m + 1)).
+ */
+constexpr double const_log(double x) {
+    int e = 0;
+    while (x >= 2.0) { x *= 0.5; ++e; }
+    while (x < 1.0) { x *= 2.0; --e; }
+    double z = (x - 1.0) / (x + 1.0), z2 = z * z;
+    double term = z, sum = 0.0;
+    for (int i = 1; i < 80; i += 2) {
+        sum += term / i;
+        term *= z2;
+    }
+    return 2.0 * sum + e * const_ln2;
+}
+
+/**
+ * @brief Квадратный корень (x >= 0), вычисляемый при компиляции (метод Ньютона).
+ */
+constexpr double const_sqrt(double x) {
+    if (x == 0.0) return 0.0;
+    double y = x > 1.0 ? x : 1.0;
+    for (int i = 0; i < 100; ++i) y = 0.5 * (y + x / y);
+    return y;
+}
+
+/**
+ * @brief Таблица зиккурата с N слоями.
+ *
+ * Слово генератора w попадает в слой i = w mod N; если |w| < k[i], значение
+ * w * w_[i] лежит внутри прямоугольника слоя и принимается сразу.
+ * f[i] — плотность на правой границе слоя i.
+ */
+template <size_t N>
+struct ZigguratTable {
+    uint32_t k[N]; ///< Пороги быстрого принятия.
+    double w[N];   ///< Масштаб слова генератора в значение.
+    double f[N];   ///< Плотность на границах слоёв.
+};
+
+/// Правая граница основания зиккурата нормального распределения (128 слоёв).
+inline constexpr double ziggurat_normal_r = 3.442619855899;
+
+/// Правая граница основания зиккурата экспоненциального распределения (256 слоёв).
+inline constexpr double ziggurat_exponential_r = 7.697117470131487;
+
+/**
+ * @brief Построение таблицы нормального распределения (плотность e^{-x^2/2}).
+ */
+constexpr ZigguratTable<128> make_ziggurat_normal() {
+    ZigguratTable<128> t{};
+    const double m1 = 2147483648.0, v = 9.91256303526217e-3;
+    double dn = ziggurat_normal_r, tn = dn;
+    const double q = v / const_exp(-0.5 * dn * dn);
+    t.k[0] = uint32_t(dn / q * m1);
+    t.k[1] = 0;
+    t.w[0] = q / m1;
+    t.w[127] = dn / m1;
+    t.f[0] = 1.0;
+    t.f[127] = const_exp(-0.5 * dn * dn);
+    for (int i = 126; i >= 1; --i) {
+        dn = const_sqrt(-2.0 * const_log(v / dn + const_exp(-0.5 * dn * dn)));
+        t.k[i + 1] = uint32_t(dn / tn * m1);
+        tn = dn;
+        t.f[i] = const_exp(-0.5 * dn * dn);
+        t.w[i] = dn / m1;
+    }
+    return t;
+}
+
+/**
+ * @brief Построение таблицы экспоненциального распределения (плотность e^{-x}).
+ */
+constexpr ZigguratTable<256> make_ziggurat_exponential() {
+    ZigguratTable<256> t{};
+    const double m2 = 4294967296.0, v = 3.949659822581572e-3;
+    double de = ziggurat_exponential_r, te = de;
+    const double q = v / const_exp(-de);
+    t.k[0] = uint32_t(de / q * m2);
+    t.k[1] = 0;
+    t.w[0] = q / m2;
+    t.w[255] = de / m2;
+    t.f[0] = 1.0;
+    t.f[255] = const_exp(-de);
+    for (int i = 254; i >= 1; --i) {
+        de = -const_log(v / de + const_exp(-de));
+        t.k[i + 1] = uint32_t(de / te * m2);
+        te = de;
+        t.f[i] = const_exp(-de);
+        t.w[i] = de / m2;
+    }
+    return t;
+}
+
+/// Таблица нормального распределения.
+inline constexpr ZigguratTable<128> ziggurat_normal = make_ziggurat_normal();
+
+/// Таблица экспоненциального распределения.
+inline constexpr ZigguratTable<256> ziggurat_exponential = make_ziggurat_exponential();
+
+/**
+ * @brief Равномерное число из (0, 1) по одному слову генератора (без нуля для log()).
+ */
+template <RandomGenerator G>
+inline double uniform_open(G &g) {
+    return (double(g.next()) + 0.5) * (1.0 / 4294967296.0);
+}
+
+/**
+ * @brief Медленный путь нормального распределения для слова, не прошедшего быстрый тест.
+ *
+ * Клин слоя проверяется по плотности, основание — хвостовым методом Марсальи;
+ * при отказе берётся новое слово генератора.
+ * @param g Генератор.
+ * @param hz Слово, отвергнутое быстрым тестом.
+ * @return Нормальное значение.
+ */
+template <RandomGenerator G>
+double normal_slow(G &g, int32_t hz) {
+    const ZigguratTable<128> &t = ziggurat_normal;
+    for (;;) {
+        uint32_t iz = uint32_t(hz) & 127u;
+        double x = hz * t.w[iz];
+        if (iz == 0) {
+            double y;
+            do {
+                x = -std::log(uniform_open(g)) / ziggurat_normal_r;
+                y = -std::log(uniform_open(g));
+            } while (y + y < x * x);
+            return hz > 0 ? ziggurat_normal_r + x : -ziggurat_normal_r - x;
+        }
+        if (t.f[iz] + uniform_open(g) * (t.f[iz - 1] - t.f[iz]) < std::exp(-0.5 * x * x)) return x;
+        hz = int32_t(g.next());
+        iz = uint32_t(hz) & 127u;
+        uint32_t a = hz < 0 ? 0u - uint32_t(hz) : uint32_t(hz);
+        if (a < t.k[iz]) return hz * t.w[iz];
+    }
+}
+
+/**
+ * @brief Медленный путь экспоненциального распределения для слова, не прошедшего быстрый тест.
+ * @param g Генератор.
+ * @param jz Слово, отвергнутое быстрым тестом.
+ * @return Экспоненциальное значение.
+ */
+template <RandomGenerator G>
+double exponential_slow(G &g, uint32_t jz) {
+    const ZigguratTable<256> &t = ziggurat_exponential;
+    for (;;) {
+        uint32_t iz = jz & 255u;
+        if (iz == 0) return ziggurat_exponential_r - std::log(uniform_open(g));
+        double x = jz * t.w[iz];
+        if (t.f[iz] + uniform_open(g) * (t.f[iz - 1] - t.f[iz]) < std::exp(-x)) return x;
+        jz = g.next();
+        iz = jz & 255u;
+        if (jz < t.k[iz]) return jz * t.w[iz];
+    }
+}
+
+/**
+ * @brief Одно нормальное значение N(0, 1).
+ */
+template <RandomGenerator G>
+inline double sample_normal(G &g) {
+    int32_t hz = int32_t(g.next());
+    uint32_t iz = uint32_t(hz) & 127u;
+    uint32_t a = hz < 0 ? 0u - uint32_t(hz) : uint32_t(hz);
+    if (a < ziggurat_normal.k[iz]) return hz * ziggurat_normal.w[iz];
+    return normal_slow(g, hz);
+}
+
+/**
+ * @brief Одно экспоненциальное значение с параметром 1.
+ */
+template <RandomGenerator G>
+inline double sample_exponential(G &g) {
+    uint32_t jz = g.next();
+    uint32_t iz = jz & 255u;
+    if (jz < ziggurat_exponential.k[iz]) return jz * ziggurat_exponential.w[iz];
+    return exponential_slow(g, jz);
+}
+
+/**
+ * @brief Быстрый путь нормального зиккурата для блока слов.
+ *
+ * Для каждого слова записывает w * w_[i]; индексы слов, не прошедших тест
+ * |w| < k[i], сохраняются в rejected.
+ * @return Количество отвергнутых слов.
+ */
+inline size_t normal_fast(const uint32_t *in, double *out, size_t n, uint32_t *rejected) {
+    const ZigguratTable<128> &t = ziggurat_normal;
+    size_t i = 0, r = 0;
+#if defined(__AVX2__)
+    const __m256i layer = _mm256_set1_epi32(127);
+    for (; i + 8 <= n; i += 8) {
+        __m256i hz = _mm256_loadu_si256((const __m256i *)(in + i));
+        __m256i iz = _mm256_and_si256(hz, layer);
+        __m256i k = _mm256_i32gather_epi32((const int *)t.k, iz, 4);
+        __m256i a = _mm256_abs_epi32(hz);
+        __m256i rej = _mm256_cmpeq_epi32(_mm256_max_epu32(a, k), a); // |hz| >= k
+        __m256d w0 = _mm256_i32gather_pd(t.w, _mm256_castsi256_si128(iz), 8);
+        __m256d w1 = _mm256_i32gather_pd(t.w, _mm256_extracti128_si256(iz, 1), 8);
+        _mm256_storeu_pd(out + i, _mm256_mul_pd(_mm256_cvtepi32_pd(_mm256_castsi256_si128(hz)), w0));
+        _mm256_storeu_pd(out + i + 4, _mm256_mul_pd(_mm256_cvtepi32_pd(_mm256_extracti128_si256(hz, 1)), w1));
+        unsigned mask = unsigned(_mm256_movemask_ps(_mm256_castsi256_ps(rej)));
+        for (; mask; mask &= mask - 1) rejected[r++] = uint32_t(i + __builtin_ctz(mask));
+    }
+#endif
+    for (; i < n; ++i) {
+        int32_t hz = int32_t(in[i]);
+        uint32_t iz = in[i] & 127u;
+        uint32_t a = hz < 0 ? 0u - uint32_t(hz) : uint32_t(hz);
+        out[i] = hz * t.w[iz];
+        if (a >= t.k[iz]) rejected[r++] = uint32_t(i);
+    }
+    return r;
+}
+
+/**
+ * @brief Быстрый путь экспоненциального зиккурата для блока слов.
+ * @return Количество отвергнутых слов (их индексы — в rejected).
+ */
+inline size_t exponential_fast(const uint32_t *in, double *out, size_t n, uint32_t *rejected) {
+    const ZigguratTable<256> &t = ziggurat_exponential;
+    size_t i = 0, r = 0;
+#if defined(__AVX2__)
+    const __m256i layer = _mm256_set1_epi32(255);
+    const __m256i sign = _mm256_set1_epi32(int(0x80000000u));
+    const __m256d half = _mm256_set1_pd(2147483648.0);
+    for (; i + 8 <= n; i += 8) {
+        __m256i jz = _mm256_loadu_si256((const __m256i *)(in + i));
+        __m256i iz = _mm256_and_si256(jz, layer);
+        __m256i k = _mm256_i32gather_epi32((const int *)t.k, iz, 4);
+        __m256i rej = _mm256_cmpeq_epi32(_mm256_max_epu32(jz, k), jz); // jz >= k
+        __m256d w0 = _mm256_i32gather_pd(t.w, _mm256_castsi256_si128(iz), 8);
+        __m256d w1 = _mm256_i32gather_pd(t.w, _mm256_extracti128_si256(iz, 1), 8);
+        // Беззнаковое -> double: (jz - 2^31) как знаковое, затем + 2^31.
+        __m256i js = _mm256_xor_si256(jz, sign);
+        __m256d x0 = _mm256_add_pd(_mm256_cvtepi32_pd(_mm256_castsi256_si128(js)), half);
+        __m256d x1 = _mm256_add_pd(_mm256_cvtepi32_pd(_mm256_extracti128_si256(js, 1)), half);
+        _mm256_storeu_pd(out + i, _mm256_mul_pd(x0, w0));
+        _mm256_storeu_pd(out + i + 4, _mm256_mul_pd(x1, w1));
+        unsigned mask = unsigned(_mm256_movemask_ps(_mm256_castsi256_ps(rej)));
+        for (; mask; mask &= mask - 1) rejected[r++] = uint32_t(i + __builtin_ctz(mask));
+    }
+#endif
+    for (; i < n; ++i) {
+        uint32_t jz = in[i], iz = jz & 255u;
+        out[i] = jz * t.w[iz];
+        if (jz >= t.k[iz]) rejected[r++] = uint32_t(i);
+    }
+    return r;
+}
+
+/**
+ * @brief Заполнение буфера нормальными значениями N(0, 1).
+ *
+ * Слова генерируются блоками через g.fill(); отвергнутые быстрым путём
+ * позиции дообрабатываются normal_slow() после блока. Результат не зависит
+ * от наличия AVX2.
+ * @param g Генератор.
+ * @param out Указатель на буфер для записи.
+ * @param n Количество генерируемых значений.
+ */
+template <RandomGenerator G>
+void fill_normal(G &g, double *out, size_t n) {
+    uint32_t buf[512], rejected[512];
+    while (n) {
+        size_t m = n < 512 ? n : 512;
+        g.fill(buf, m);
+        size_t r = normal_fast(buf, out, m, rejected);
+        for (size_t j = 0; j < r; ++j) out[rejected[j]] = normal_slow(g, int32_t(buf[rejected[j]]));
+        out += m;
+        n -= m;
+    }
+}
+
+/**
+ * @brief Заполнение буфера экспоненциальными значениями с параметром 1.
+ * @param g Генератор.
+ * @param out Указатель на буфер для записи.
+ * @param n Количество генерируемых значений.
+ */
+template <RandomGenerator G>
+void fill_exponential(G &g, double *out, size_t n) {
+    uint32_t buf[512], rejected[512];
+    while (n) {
+        size_t m = n < 512 ? n : 512;
+        g.fill(buf, m);
+        size_t r = exponential_fast(buf, out, m, rejected);
+        for (size_t j = 0; j < r; ++j) out[rejected[j]] = exponential_slow(g, buf[rejected[j]]);
+        out += m;
+        n -= m;
+    }
+}
+
+#endif // DISTRIBUTIONS_H
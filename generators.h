@@ -7,16 +7,295 @@
 #define GENERATORS_H
 
 #include <cstdint>
+#include <cstddef>
+#include <concepts>
+#include <random>
+#include <sstream>
+#include <type_traits>
+#include <cstring>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/**
+ * @brief Проверка условия Халла — Добелла для модуля 2^32.
+ *
+ * LCG имеет полный период 2^32 тогда и только тогда, когда c нечётно
+ * и a = 1 (mod 4).
+ */
+constexpr bool lcg_full_period(uint32_t a, uint32_t c) {
+    return (c & 1u) == 1u && (a & 3u) == 1u;
+}
+
+/**
+ * @brief Заполнение буфера 64-битными значениями из 32-битного генератора.
+ *
+ * Каждое 64-битное значение собирается из двух подряд идущих 32-битных:
+ * первое — младшие биты, второе — старшие (как next64()). Значения
+ * запрашиваются блоками через g.fill(), поэтому векторный путь генератора
+ * сохраняется.
+ */
+template <class G>
+inline void fill64_from32(G &g, uint64_t *out, size_t n) {
+    uint32_t buf[512];
+    while (n) {
+        size_t m = n < 256 ? n : 256;
+        g.fill(buf, 2 * m);
+        for (size_t i = 0; i < m; ++i) out[i] = buf[2 * i] | (uint64_t(buf[2 * i + 1]) << 32);
+        out += m;
+        n -= m;
+    }
+}
+
+/**
+ * @brief Преобразование 64-битных слов в числа double на [0, 1) внедрением мантиссы.
+ *
+ * Старшие 52 бита слова становятся мантиссой числа с нулевым порядком
+ * (значение из [1, 2)), из которого вычитается 1. Шаг сетки 2^-52;
+ * нет ни деления, ни преобразования целое -> double.
+ * @param in Исходные слова.
+ * @param out Буфер для записи (может не быть выровнен).
+ * @param n Количество значений.
+ */
+inline void unit_double_from_bits(const uint64_t *in, double *out, size_t n) {
+    size_t i = 0;
+#if defined(__AVX2__)
+    const __m256i exponent = _mm256_set1_epi64x(0x3FF0000000000000ll);
+    const __m256d one = _mm256_set1_pd(1.0);
+    for (; i + 4 <= n; i += 4) {
+        __m256i v = _mm256_loadu_si256((const __m256i *)(in + i));
+        v = _mm256_or_si256(_mm256_srli_epi64(v, 12), exponent);
+        _mm256_storeu_pd(out + i, _mm256_sub_pd(_mm256_castsi256_pd(v), one));
+    }
+#elif defined(__SSE2__)
+    const __m128i exponent = _mm_set1_epi64x(0x3FF0000000000000ll);
+    const __m128d one = _mm_set1_pd(1.0);
+    for (; i + 2 <= n; i += 2) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(in + i));
+        v = _mm_or_si128(_mm_srli_epi64(v, 12), exponent);
+        _mm_storeu_pd(out + i, _mm_sub_pd(_mm_castsi128_pd(v), one));
+    }
+#endif
+    for (; i < n; ++i) {
+        uint64_t bits = (in[i] >> 12) | 0x3FF0000000000000ull;
+        double d;
+        memcpy(&d, &bits, sizeof(d));
+        out[i] = d - 1.0;
+    }
+}
+
+/**
+ * @brief Преобразование 32-битных слов в числа float на [0, 1) внедрением мантиссы.
+ *
+ * Старшие 23 бита слова становятся мантиссой числа из [1, 2), из которого
+ * вычитается 1. Шаг сетки 2^-23.
+ * @param in Исходные слова.
+ * @param out Буфер для записи (может не быть выровнен).
+ * @param n Количество значений.
+ */
+inline void unit_float_from_bits(const uint32_t *in, float *out, size_t n) {
+    size_t i = 0;
+#if defined(__AVX2__)
+    const __m256i exponent = _mm256_set1_epi32(0x3F800000);
+    const __m256 one = _mm256_set1_ps(1.0f);
+    for (; i + 8 <= n; i += 8) {
+        __m256i v = _mm256_loadu_si256((const __m256i *)(in + i));
+        v = _mm256_or_si256(_mm256_srli_epi32(v, 9), exponent);
+        _mm256_storeu_ps(out + i, _mm256_sub_ps(_mm256_castsi256_ps(v), one));
+    }
+#elif defined(__SSE2__)
+    const __m128i exponent = _mm_set1_epi32(0x3F800000);
+    const __m128 one = _mm_set1_ps(1.0f);
+    for (; i + 4 <= n; i += 4) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(in + i));
+        v = _mm_or_si128(_mm_srli_epi32(v, 9), exponent);
+        _mm_storeu_ps(out + i, _mm_sub_ps(_mm_castsi128_ps(v), one));
+    }
+#endif
+    for (; i < n; ++i) {
+        uint32_t bits = (in[i] >> 9) | 0x3F800000u;
+        float f;
+        memcpy(&f, &bits, sizeof(f));
+        out[i] = f - 1.0f;
+    }
+}
+
+/**
+ * @brief Отображение 32-битных слов на [0, k) умножением со сдвигом (Лемир), на месте.
+ *
+ * Значение x переходит в старшую половину произведения x * k. Результат
+ * несмещён, если отбросить слова, у которых младшая половина произведения
+ * меньше t = 2^32 mod k. Отброшенные позиции не останавливают обработку
+ * блока: их индексы записываются в rejected и заполняются вызывающим кодом.
+ * @param x Слова генератора на входе, числа из [0, k) на выходе.
+ * @param n Количество значений.
+ * @param k Граница диапазона (k > 0).
+ * @param t Порог отбрасывания 2^32 mod k.
+ * @param rejected Буфер для индексов отброшенных позиций (не меньше n элементов).
+ * @return Количество отброшенных позиций.
+ */
+inline size_t bounded_from_bits(uint32_t *x, size_t n, uint32_t k, uint32_t t, uint32_t *rejected) {
+    size_t i = 0, r = 0;
+#if defined(__AVX2__)
+    const __m256i kv = _mm256_set1_epi32(int(k));
+    const __m256i tv = _mm256_set1_epi32(int(t));
+    for (; i + 8 <= n; i += 8) {
+        __m256i v = _mm256_loadu_si256((const __m256i *)(x + i));
+        __m256i pe = _mm256_mul_epu32(v, kv);                        // произведения чётных дорожек
+        __m256i po = _mm256_mul_epu32(_mm256_srli_epi64(v, 32), kv); // произведения нечётных дорожек
+        __m256i hi = _mm256_blend_epi32(_mm256_srli_epi64(pe, 32), po, 0xAA);
+        _mm256_storeu_si256((__m256i *)(x + i), hi);
+        if (t) {
+            __m256i lo = _mm256_blend_epi32(pe, _mm256_slli_epi64(po, 32), 0xAA);
+            __m256i ok = _mm256_cmpeq_epi32(_mm256_max_epu32(lo, tv), lo); // lo >= t
+            unsigned mask = ~unsigned(_mm256_movemask_ps(_mm256_castsi256_ps(ok))) & 0xFFu;
+            for (; mask; mask &= mask - 1) rejected[r++] = uint32_t(i + __builtin_ctz(mask));
+        }
+    }
+#endif
+    for (; i < n; ++i) {
+        uint64_t m = uint64_t(x[i]) * k;
+        x[i] = uint32_t(m >> 32);
+        if (uint32_t(m) < t) rejected[r++] = uint32_t(i);
+    }
+    return r;
+}
+
+/**
+ * @brief Заполнение буфера несмещёнными числами из [0, k) (метод Лемира).
+ *
+ * Слова генерируются блоками прямо в out и отображаются на месте функцией
+ * bounded_from_bits(). Деление — одно на вызов (порог t); редкие отброшенные
+ * позиции заполняются после обработки блока скалярным циклом с отбрасыванием.
+ * Результат не зависит от наличия AVX2.
+ * @param g Генератор с fill() и next().
+ * @param out Указатель на буфер для записи.
+ * @param n Количество генерируемых значений.
+ * @param k Граница диапазона; k = 0 означает полный диапазон 2^32.
+ */
+template <class G>
+inline void fill_bounded_from(G &g, uint32_t *out, size_t n, uint32_t k) {
+    if (k == 0) {
+        g.fill(out, n);
+        return;
+    }
+    const uint32_t t = uint32_t(-k) % k;
+    uint32_t rejected[512];
+    while (n) {
+        size_t m = n < 512 ? n : 512;
+        g.fill(out, m);
+        size_t r = bounded_from_bits(out, m, k, t, rejected);
+        for (size_t j = 0; j < r; ++j) {
+            uint64_t p;
+            do p = uint64_t(g.next()) * k;
+            while (uint32_t(p) < t);
+            out[rejected[j]] = uint32_t(p >> 32);
+        }
+        out += m;
+        n -= m;
+    }
+}
+
+/**
+ * @brief Заполнение буфера числами double на [0, 1) из генератора с fill64().
+ *
+ * Слова генерируются блоками, которые помещаются в L1, и сразу преобразуются.
+ */
+template <class G>
+inline void fill_unit_double(G &g, double *out, size_t n) {
+    uint64_t buf[256];
+    while (n) {
+        size_t m = n < 256 ? n : 256;
+        g.fill64(buf, m);
+        unit_double_from_bits(buf, out, m);
+        out += m;
+        n -= m;
+    }
+}
+
+/**
+ * @brief Заполнение буфера числами float на [0, 1) из генератора с fill().
+ */
+template <class G>
+inline void fill_unit_float(G &g, float *out, size_t n) {
+    uint32_t buf[512];
+    while (n) {
+        size_t m = n < 512 ? n : 512;
+        g.fill(buf, m);
+        unit_float_from_bits(buf, out, m);
+        out += m;
+        n -= m;
+    }
+}
+
+/**
+ * @brief Общие производные операции генератора (CRTP).
+ *
+ * Наследник предоставляет next() и fill(); BlockApi выводит из них
+ * остальной блочный интерфейс. Генератор с собственным 64-битным выходом
+ * объявляет свои next64() / fill64(), которые скрывают версии по умолчанию.
+ * @tparam D Тип генератора-наследника.
+ */
+template <class D>
+struct BlockApi {
+    /**
+     * @brief Генерация 64-битного значения из двух очередных 32-битных.
+     * @return Первое значение в младших битах, второе — в старших.
+     */
+    inline uint64_t next64() {
+        uint64_t lo = self().next();
+        return lo | (uint64_t(self().next()) << 32);
+    }
+
+    /**
+     * @brief Заполнение буфера 64-битными значениями (см. next64() и fill64_from32()).
+     * @param out Указатель на буфер для записи.
+     * @param n Количество генерируемых 64-битных значений.
+     */
+    inline void fill64(uint64_t *out, size_t n) { fill64_from32(self(), out, n); }
+
+    /**
+     * @brief Заполнение буфера числами double, равномерными на [0, 1) (см. fill_unit_double()).
+     * @param out Указатель на буфер для записи.
+     * @param n Количество генерируемых значений.
+     */
+    inline void fill_double(double *out, size_t n) { fill_unit_double(self(), out, n); }
+
+    /**
+     * @brief Заполнение буфера числами float, равномерными на [0, 1) (см. fill_unit_float()).
+     * @param out Указатель на буфер для записи.
+     * @param n Количество генерируемых значений.
+     */
+    inline void fill_float(float *out, size_t n) { fill_unit_float(self(), out, n); }
+
+    /**
+     * @brief Заполнение буфера несмещёнными числами из [0, k) (см. fill_bounded_from()).
+     * @param out Указатель на буфер для записи.
+     * @param n Количество генерируемых значений.
+     * @param k Граница диапазона (0 — полный диапазон).
+     */
+    inline void fill_bounded(uint32_t *out, size_t n, uint32_t k) { fill_bounded_from(self(), out, n, k); }
+
+private:
+    D &self() { return static_cast<D &>(*this); }
+};
 
 /**
  * @brief Линейный конгруэнтный генератор (LCG).
  *
  * Использует формулу: X_{n+1} = a * X_n + c (mod 2^32)
+ * @tparam A Множитель (по умолчанию 1664525).
+ * @tparam C Прибавка (по умолчанию 1013904223).
  */
-struct LCG {
+template <uint32_t A = 1664525u, uint32_t C = 1013904223u>
+struct LCG : BlockApi<LCG<A, C>> {
+    static_assert(lcg_full_period(A, C), "LCG parameters violate the Hull-Dobell full-period condition");
+
     uint32_t state; ///< Текущее состояние генератора.
-    static constexpr uint32_t a = 1664525u; ///< Множитель.
-    static constexpr uint32_t c = 1013904223u; ///< Прибавка.
+    static constexpr uint32_t a = A; ///< Множитель.
+    static constexpr uint32_t c = C; ///< Прибавка.
 
     /**
      * @brief Конструктор генератора.
@@ -29,6 +308,175 @@ struct LCG {
      * @return Следующее значение в последовательности.
      */
     inline uint32_t next() { return state = a * state + c; }
+
+    /**
+     * @brief Аффинное отображение X -> mul * X + add (mod 2^32).
+     */
+    struct Affine {
+        uint32_t mul; ///< Множитель.
+        uint32_t add; ///< Прибавка.
+    };
+
+    /**
+     * @brief Вычисляет отображение k шагов генератора: X_{n+k} = mul * X_n + add.
+     *
+     * Отображения композируются возведением в степень за O(log k) умножений.
+     * @param k Количество шагов.
+     * @return Аффинное отображение k шагов.
+     */
+    static constexpr Affine leap(uint64_t k) {
+        uint32_t acc_mul = 1u, acc_add = 0u;
+        uint32_t cur_mul = a, cur_add = c;
+        while (k) {
+            if (k & 1u) {
+                acc_mul = cur_mul * acc_mul;
+                acc_add = cur_mul * acc_add + cur_add;
+            }
+            cur_add = (cur_mul + 1u) * cur_add;
+            cur_mul = cur_mul * cur_mul;
+            k >>= 1;
+        }
+        return Affine{acc_mul, acc_add};
+    }
+
+    /**
+     * @brief Пропуск k значений последовательности за O(log k).
+     * @param k Количество пропускаемых значений.
+     */
+    inline void discard(uint64_t k) {
+        Affine f = leap(k);
+        state = f.mul * state + f.add;
+    }
+
+    /**
+     * @brief Значение, которое вернёт next() после пропуска k значений.
+     *
+     * Состояние генератора не изменяется; at(0) совпадает со следующим next().
+     * @param k Смещение относительно текущей позиции.
+     * @return Значение последовательности на позиции k.
+     */
+    inline uint32_t at(uint64_t k) const {
+        Affine f = leap(k + 1);
+        return f.mul * state + f.add;
+    }
+
+    /**
+     * @brief Заполнение буфера очередными значениями последовательности.
+     *
+     * Последовательность разбивается на 4 независимые цепочки с шагом 4
+     * (X_{n+4} = a^4 * X_n + c_4), что убирает зависимость между соседними
+     * умножениями. При сборке с AVX2 используются 8 цепочек с шагом 8, по одной
+     * на каждую 32-битную дорожку регистра (X_{n+8} = a^8 * X_n + c_8).
+     * Результат совпадает с n вызовами next().
+     * @param out Указатель на буфер для записи.
+     * @param n Количество генерируемых значений.
+     */
+    inline void fill(uint32_t *out, size_t n) {
+        constexpr Affine f4 = leap(4);
+#if defined(__AVX2__)
+        if (n >= 16) {
+            constexpr Affine f8 = leap(8);
+            alignas(32) uint32_t lanes[8];
+            uint32_t x = state;
+            for (int j = 0; j < 8; ++j) lanes[j] = x = a * x + c;
+            __m256i v = _mm256_load_si256((const __m256i *)lanes);
+            const __m256i va = _mm256_set1_epi32((int)f8.mul);
+            const __m256i vc = _mm256_set1_epi32((int)f8.add);
+            size_t i = 0;
+            for (; i + 8 <= n; i += 8) {
+                _mm256_storeu_si256((__m256i *)(out + i), v);
+                v = _mm256_add_epi32(_mm256_mullo_epi32(v, va), vc);
+            }
+            state = out[i - 1];
+            for (; i < n; ++i) out[i] = next();
+            return;
+        }
+#endif
+        if (n < 8) {
+            for (size_t i = 0; i < n; ++i) out[i] = next();
+            return;
+        }
+        uint32_t x0 = a * state + c;
+        uint32_t x1 = a * x0 + c;
+        uint32_t x2 = a * x1 + c;
+        uint32_t x3 = a * x2 + c;
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            out[i] = x0; out[i + 1] = x1; out[i + 2] = x2; out[i + 3] = x3;
+            x0 = f4.mul * x0 + f4.add; x1 = f4.mul * x1 + f4.add;
+            x2 = f4.mul * x2 + f4.add; x3 = f4.mul * x3 + f4.add;
+        }
+        state = out[i - 1];
+        for (; i < n; ++i) out[i] = next();
+    }
+};
+
+/**
+ * @brief Пара параметров (a, c) генератора LCG.
+ */
+struct LCGParams {
+    uint32_t a; ///< Множитель.
+    uint32_t c; ///< Прибавка.
+};
+
+/// Известные параметры LCG с модулем 2^32 (Numerical Recipes, Borland, ANSI C, MSVC).
+inline constexpr LCGParams lcg_known_params[] = {
+    {1664525u, 1013904223u},
+    {22695477u, 1u},
+    {1103515245u, 12345u},
+    {214013u, 2531011u},
+};
+
+/// Количество вариантов в семействе LCG (известные + сгенерированные).
+inline constexpr size_t lcg_family_size = 256;
+
+/**
+ * @brief Параметры i-го варианта семейства LCG.
+ *
+ * Первые варианты — известные параметры, остальные получаются сдвигом
+ * множителя на шаг, кратный 4, и прибавки на чётный шаг, что сохраняет
+ * условие полного периода.
+ * @param i Номер варианта (0 <= i < lcg_family_size).
+ */
+constexpr LCGParams lcg_family_params(size_t i) {
+    constexpr size_t known = sizeof(lcg_known_params) / sizeof(lcg_known_params[0]);
+    if (i < known) return lcg_known_params[i];
+    uint32_t k = uint32_t(i - known + 1);
+    return LCGParams{1664525u + 4u * 104729u * k, 1013904223u + 2u * 7919u * k};
+}
+
+/// i-й вариант семейства LCG как отдельный тип.
+template <size_t I>
+using LCGFamily = LCG<lcg_family_params(I).a, lcg_family_params(I).c>;
+
+/**
+ * @brief Матрица 32x32 над GF(2), хранимая по столбцам.
+ *
+ * col[j] — образ базисного вектора e_j, поэтому умножение на вектор сводится
+ * к XOR столбцов, соответствующих единичным битам вектора.
+ */
+struct GF2Mat32 {
+    uint32_t col[32]; ///< Столбцы матрицы.
+
+    /**
+     * @brief Умножение матрицы на вектор.
+     * @param v Вектор из 32 бит.
+     * @return M * v.
+     */
+    constexpr uint32_t apply(uint32_t v) const {
+        uint32_t r = 0;
+        for (int j = 0; j < 32; ++j) r ^= col[j] & (0u - ((v >> j) & 1u));
+        return r;
+    }
+
+    /**
+     * @brief Произведение матриц (this * b).
+     */
+    constexpr GF2Mat32 operator*(const GF2Mat32 &b) const {
+        GF2Mat32 r{};
+        for (int j = 0; j < 32; ++j) r.col[j] = apply(b.col[j]);
+        return r;
+    }
 };
 
 /**
@@ -36,7 +484,7 @@ struct LCG {
  *
  * Быстрый генератор на основе побитовых операций XOR и сдвигов.
  */
-struct XORShift32 {
+struct XORShift32 : BlockApi<XORShift32> {
     uint32_t state; ///< Текущее состояние генератора.
 
     /**
@@ -56,6 +504,166 @@ struct XORShift32 {
         x ^= x << 5;
         return state = x;
     }
+
+    /// Период генератора: все ненулевые состояния образуют один цикл.
+    static constexpr uint64_t period = 0xFFFFFFFFull;
+
+    /**
+     * @brief Один шаг генератора как функция состояния.
+     */
+    static constexpr uint32_t step(uint32_t x) {
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        return x;
+    }
+
+    /**
+     * @brief Матрица шага генератора над GF(2).
+     */
+    static constexpr GF2Mat32 matrix() {
+        GF2Mat32 m{};
+        for (int j = 0; j < 32; ++j) m.col[j] = step(1u << j);
+        return m;
+    }
+
+    /**
+     * @brief Таблица степеней матрицы шага: pow[i] = M^(2^i), i = 0..31.
+     */
+    struct JumpTable {
+        GF2Mat32 pow[32]; ///< Степени матрицы шага.
+    };
+
+    /**
+     * @brief Построение таблицы степеней M^(2^i) последовательным возведением в квадрат.
+     */
+    static constexpr JumpTable jump_table() {
+        JumpTable t{};
+        t.pow[0] = matrix();
+        for (int i = 1; i < 32; ++i) t.pow[i] = t.pow[i - 1] * t.pow[i - 1];
+        return t;
+    }
+
+    /**
+     * @brief Пропуск k значений последовательности за O(log k).
+     *
+     * k приводится по модулю периода, затем состояние умножается на M^(2^i)
+     * для каждого единичного бита k (таблица строится на этапе компиляции).
+     * @param k Количество пропускаемых значений.
+     */
+    inline void discard(uint64_t k) {
+        static constexpr JumpTable table = jump_table();
+        k %= period;
+        uint32_t x = state;
+        for (int i = 0; k; ++i, k >>= 1)
+            if (k & 1u) x = table.pow[i].apply(x);
+        state = x;
+    }
+
+    /**
+     * @brief Младшие 32 коэффициента характеристического многочлена матрицы шага.
+     *
+     * Многочлен p(x) = x^32 + ... находится алгоритмом Берлекэмпа — Месси
+     * по младшему биту 64 последовательных состояний; x^32 подразумевается.
+     */
+    static constexpr uint32_t charpoly() {
+        uint64_t bits = 0;
+        uint32_t x = 1u;
+        for (int i = 0; i < 64; ++i) {
+            bits |= uint64_t(x & 1u) << i;
+            x = step(x);
+        }
+        uint64_t C = 1, B = 1;
+        int L = 0, m = 1;
+        for (int n = 0; n < 64; ++n) {
+            uint64_t d = (bits >> n) & 1u;
+            for (int i = 1; i <= L; ++i) d ^= ((C >> i) & 1u) & ((bits >> (n - i)) & 1u);
+            if (!d) {
+                ++m;
+            } else if (2 * L <= n) {
+                uint64_t T = C;
+                C ^= B << m;
+                L = n + 1 - L;
+                B = T;
+                m = 1;
+            } else {
+                C ^= B << m;
+                ++m;
+            }
+        }
+        // Многочлен связи C(x) переводится в характеристический x^L * C(1/x).
+        uint32_t p = 0;
+        for (int i = 1; i <= L; ++i) p |= uint32_t((C >> i) & 1u) << (L - i);
+        return p;
+    }
+
+    /**
+     * @brief Умножение многочленов степени < 32 по модулю характеристического многочлена.
+     */
+    static constexpr uint32_t polymulmod(uint32_t a, uint32_t b, uint32_t p) {
+        uint32_t r = 0;
+        for (int i = 31; i >= 0; --i) {
+            r = (r << 1) ^ (p & (0u - (r >> 31)));
+            if ((b >> i) & 1u) r ^= a;
+        }
+        return r;
+    }
+
+    /**
+     * @brief Многочлен прыжка x^k mod p(x).
+     *
+     * Вычисляется один раз для смещения k и затем применяется через jump()
+     * к любому числу состояний, например при разбиении потока между ядрами.
+     * @param k Смещение.
+     * @return Коэффициенты многочлена (бит i — коэффициент при x^i).
+     */
+    static constexpr uint32_t jump_polynomial(uint64_t k) {
+        constexpr uint32_t p = charpoly();
+        uint32_t r = 1u, base = 2u;
+        for (k %= period; k; k >>= 1) {
+            if (k & 1u) r = polymulmod(r, base, p);
+            base = polymulmod(base, base, p);
+        }
+        return r;
+    }
+
+    /**
+     * @brief Прыжок по заранее вычисленному многочлену: state = r(M) * state.
+     *
+     * Схема Горнера требует 32 шагов генератора и не использует таблиц.
+     * @param poly Многочлен, полученный из jump_polynomial().
+     */
+    inline void jump(uint32_t poly) {
+        uint32_t acc = 0;
+        for (int i = 31; i >= 0; --i) {
+            acc = step(acc);
+            if ((poly >> i) & 1u) acc ^= state;
+        }
+        state = acc;
+    }
+
+    /**
+     * @brief Заполнение буфера очередными значениями последовательности.
+     *
+     * Цикл развёрнут на 4 шага, состояние держится в регистре.
+     * Результат совпадает с n вызовами next().
+     * @param out Указатель на буфер для записи.
+     * @param n Количество генерируемых значений.
+     */
+    inline void fill(uint32_t *out, size_t n) {
+        uint32_t x = state;
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            x ^= x << 13; x ^= x >> 17; x ^= x << 5; out[i] = x;
+            x ^= x << 13; x ^= x >> 17; x ^= x << 5; out[i + 1] = x;
+            x ^= x << 13; x ^= x >> 17; x ^= x << 5; out[i + 2] = x;
+            x ^= x << 13; x ^= x >> 17; x ^= x << 5; out[i + 3] = x;
+        }
+        for (; i < n; ++i) {
+            x ^= x << 13; x ^= x >> 17; x ^= x << 5; out[i] = x;
+        }
+        state = x;
+    }
 };
 
 /**
@@ -63,7 +671,7 @@ struct XORShift32 {
  *
  * Использует умножение и перенос для генерации случайных чисел.
  */
-struct MWC {
+struct MWC : BlockApi<MWC> {
     uint32_t state; ///< Основное состояние генератора.
     uint32_t carry; ///< Перенос при умножении.
     static constexpr uint32_t a = 4294957665u; ///< Множитель.
@@ -86,6 +694,1314 @@ struct MWC {
         carry = uint32_t(p >> 32);
         return state;
     }
+
+    /// Простой модуль эквивалентного генератора Лемера: m = a * 2^32 - 1.
+    static constexpr uint64_t modulus = (uint64_t(a) << 32) - 1u;
+
+    /**
+     * @brief Умножение по модулю m через 128-битное произведение.
+     */
+    static constexpr uint64_t mulmod(uint64_t x, uint64_t y) {
+        return uint64_t((unsigned __int128)x * y % modulus);
+    }
+
+    /**
+     * @brief Возведение a в степень k по модулю m за O(log k) умножений.
+     */
+    static constexpr uint64_t powmod(uint64_t k) {
+        uint64_t r = 1u, base = a;
+        for (; k; k >>= 1) {
+            if (k & 1u) r = mulmod(r, base);
+            base = mulmod(base, base);
+        }
+        return r;
+    }
+
+    /**
+     * @brief Пропуск k значений последовательности за O(log k).
+     *
+     * Число z = carry * 2^32 + state удовлетворяет z_{n+1} = a * z_n (mod m),
+     * т.е. MWC совпадает с генератором Лемера по модулю m = a * 2^32 - 1.
+     * Поэтому z_{n+k} = a^k * z_n (mod m). Начальные состояния с z > m
+     * (перенос не меньше a) сначала продвигаются обычными шагами — таких
+     * шагов не больше двух.
+     * @param k Количество пропускаемых значений.
+     */
+    inline void discard(uint64_t k) {
+        uint64_t z = (uint64_t(carry) << 32) | state;
+        for (; k && z > modulus; --k) {
+            next();
+            z = (uint64_t(carry) << 32) | state;
+        }
+        if (!k || z == modulus) return;
+        z = mulmod(z, powmod(k));
+        state = uint32_t(z);
+        carry = uint32_t(z >> 32);
+    }
+
+    /**
+     * @brief Заполнение буфера очередными значениями последовательности.
+     *
+     * Цикл развёрнут на 4 шага, состояние и перенос держатся в регистрах.
+     * Результат совпадает с n вызовами next().
+     * @param out Указатель на буфер для записи.
+     * @param n Количество генерируемых значений.
+     */
+    inline void fill(uint32_t *out, size_t n) {
+        uint64_t p = (uint64_t(carry) << 32) | state;
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            p = uint64_t(a) * uint32_t(p) + (p >> 32); out[i] = uint32_t(p);
+            p = uint64_t(a) * uint32_t(p) + (p >> 32); out[i + 1] = uint32_t(p);
+            p = uint64_t(a) * uint32_t(p) + (p >> 32); out[i + 2] = uint32_t(p);
+            p = uint64_t(a) * uint32_t(p) + (p >> 32); out[i + 3] = uint32_t(p);
+        }
+        for (; i < n; ++i) {
+            p = uint64_t(a) * uint32_t(p) + (p >> 32); out[i] = uint32_t(p);
+        }
+        state = uint32_t(p);
+        carry = uint32_t(p >> 32);
+    }
+};
+
+/**
+ * @brief Генератор PCG32 (PCG-XSH-RR 64/32).
+ *
+ * 64-битный LCG X_{n+1} = a * X_n + inc (mod 2^64) с выходной перестановкой
+ * XSH-RR: сдвиг-XOR старших бит и циклический сдвиг на величину, заданную
+ * старшими 5 битами состояния. Нечётное inc выбирает один из 2^63 потоков.
+ */
+struct PCG32 : BlockApi<PCG32> {
+    uint64_t state; ///< Текущее состояние генератора.
+    uint64_t inc;   ///< Прибавка (всегда нечётна), задаёт поток.
+    static constexpr uint64_t a = 6364136223846793005ull; ///< Множитель.
+
+    /**
+     * @brief Конструктор генератора.
+     * @param s Начальное значение состояния.
+     * @param stream Номер потока (по умолчанию поток из эталонной реализации).
+     */
+    PCG32(uint64_t s = 0x853c49e6748fea9bull, uint64_t stream = 0xda3e39cb94b95bdbull)
+        : state(0u), inc((stream << 1) | 1u) {
+        next();
+        state += s;
+        next();
+    }
+
+    /**
+     * @brief Выходная перестановка XSH-RR.
+     * @param old Состояние до шага.
+     * @return 32-битное выходное значение.
+     */
+    static constexpr uint32_t output(uint64_t old) {
+        uint32_t xorshifted = uint32_t(((old >> 18) ^ old) >> 27);
+        uint32_t rot = uint32_t(old >> 59);
+        return (xorshifted >> rot) | (xorshifted << ((32u - rot) & 31u));
+    }
+
+    /**
+     * @brief Генерация следующего псевдослучайного числа.
+     * @return Следующее значение в последовательности.
+     */
+    inline uint32_t next() {
+        uint64_t old = state;
+        state = a * old + inc;
+        return output(old);
+    }
+
+    /**
+     * @brief Аффинное отображение X -> mul * X + add (mod 2^64).
+     */
+    struct Affine {
+        uint64_t mul; ///< Множитель.
+        uint64_t add; ///< Прибавка.
+    };
+
+    /**
+     * @brief Отображение k шагов генератора с прибавкой c (возведение в степень за O(log k)).
+     */
+    static constexpr Affine leap(uint64_t k, uint64_t c) {
+        uint64_t acc_mul = 1u, acc_add = 0u;
+        uint64_t cur_mul = a, cur_add = c;
+        while (k) {
+            if (k & 1u) {
+                acc_mul = cur_mul * acc_mul;
+                acc_add = cur_mul * acc_add + cur_add;
+            }
+            cur_add = (cur_mul + 1u) * cur_add;
+            cur_mul = cur_mul * cur_mul;
+            k >>= 1;
+        }
+        return Affine{acc_mul, acc_add};
+    }
+
+    /**
+     * @brief Продвижение генератора на k шагов за O(log k).
+     * @param k Количество пропускаемых значений.
+     */
+    inline void advance(uint64_t k) {
+        Affine f = leap(k, inc);
+        state = f.mul * state + f.add;
+    }
+
+    /**
+     * @brief Синоним advance() для единообразия с другими генераторами.
+     */
+    inline void discard(uint64_t k) { advance(k); }
+
+    /**
+     * @brief Заполнение буфера очередными значениями последовательности.
+     *
+     * Последовательность состояний разбивается на 4 независимые цепочки с шагом 4,
+     * так что умножения соседних значений не зависят друг от друга, а выходная
+     * перестановка вычисляется блоком. Результат совпадает с n вызовами next().
+     * @param out Указатель на буфер для записи.
+     * @param n Количество генерируемых значений.
+     */
+    inline void fill(uint32_t *out, size_t n) {
+        if (n < 8) {
+            for (size_t i = 0; i < n; ++i) out[i] = next();
+            return;
+        }
+        const Affine f4 = leap(4, inc);
+        uint64_t x[4];
+        x[0] = state;
+        for (int j = 1; j < 4; ++j) x[j] = a * x[j - 1] + inc;
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            for (int j = 0; j < 4; ++j) {
+                out[i + j] = output(x[j]);
+                x[j] = f4.mul * x[j] + f4.add;
+            }
+        }
+        state = x[0];
+        for (; i < n; ++i) out[i] = next();
+    }
+};
+
+/**
+ * @brief Генератор SplitMix64; используется для заполнения состояний из одного зерна.
+ * @param x Состояние SplitMix64 (продвигается на один шаг).
+ * @return Следующее 64-битное значение.
+ */
+constexpr uint64_t splitmix64(uint64_t &x) {
+    uint64_t z = (x += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+/**
+ * @brief Генератор xoshiro128** (Блэкман, Винья), 128 бит состояния, 32-битный выход.
+ *
+ * Период 2^128 - 1. jump() продвигает генератор на 2^64 шагов,
+ * long_jump() — на 2^96, что даёт непересекающиеся подпоследовательности.
+ */
+struct Xoshiro128StarStar : BlockApi<Xoshiro128StarStar> {
+    uint32_t s[4]; ///< Состояние генератора (не все нули).
+
+    /**
+     * @brief Конструктор: состояние заполняется генератором SplitMix64 из зерна.
+     * @param seed Начальное значение.
+     */
+    Xoshiro128StarStar(uint64_t seed = 1u) {
+        uint64_t x = seed;
+        uint64_t a = splitmix64(x), b = splitmix64(x);
+        s[0] = uint32_t(a); s[1] = uint32_t(a >> 32);
+        s[2] = uint32_t(b); s[3] = uint32_t(b >> 32);
+    }
+
+    /// Циклический сдвиг 32-битного числа влево.
+    static constexpr uint32_t rotl(uint32_t x, int k) { return (x << k) | (x >> (32 - k)); }
+
+    /**
+     * @brief Генерация следующего псевдослучайного числа.
+     * @return Следующее значение в последовательности.
+     */
+    inline uint32_t next() {
+        const uint32_t result = rotl(s[1] * 5u, 7) * 9u;
+        const uint32_t t = s[1] << 9;
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = rotl(s[3], 11);
+        return result;
+    }
+
+    /**
+     * @brief Заполнение буфера очередными значениями последовательности.
+     *
+     * Состояние держится в регистрах на всё время заполнения.
+     * @param out Указатель на буфер для записи.
+     * @param n Количество генерируемых значений.
+     */
+    inline void fill(uint32_t *out, size_t n) {
+        Xoshiro128StarStar g = *this;
+        for (size_t i = 0; i < n; ++i) out[i] = g.next();
+        *this = g;
+    }
+
+    /**
+     * @brief Прыжок по многочлену: state = P(M) * state.
+     * @param poly Коэффициенты многочлена прыжка (128 бит).
+     */
+    inline void jump_by(const uint32_t (&poly)[4]) {
+        uint32_t t[4] = {0, 0, 0, 0};
+        for (int i = 0; i < 4; ++i)
+            for (int b = 0; b < 32; ++b) {
+                if (poly[i] & (1u << b))
+                    for (int k = 0; k < 4; ++k) t[k] ^= s[k];
+                next();
+            }
+        for (int k = 0; k < 4; ++k) s[k] = t[k];
+    }
+
+    /**
+     * @brief Продвижение на 2^64 шагов (официальный многочлен прыжка).
+     */
+    inline void jump() {
+        static constexpr uint32_t poly[4] = {0x8764000bu, 0xf542d2d3u, 0x6fa035c3u, 0x77f2db5bu};
+        jump_by(poly);
+    }
+
+    /**
+     * @brief Продвижение на 2^96 шагов (официальный многочлен дальнего прыжка).
+     */
+    inline void long_jump() {
+        static constexpr uint32_t poly[4] = {0xb523952eu, 0x0b6f099fu, 0xccf5a0efu, 0x1c580662u};
+        jump_by(poly);
+    }
 };
 
+/**
+ * @brief Генератор xoshiro256** (Блэкман, Винья), 256 бит состояния, 64-битный выход.
+ *
+ * Период 2^256 - 1. jump() продвигает генератор на 2^128 шагов,
+ * long_jump() — на 2^192. next() возвращает старшие 32 бита очередного
+ * 64-битного значения, next64() — значение целиком.
+ */
+struct Xoshiro256StarStar : BlockApi<Xoshiro256StarStar> {
+    uint64_t s[4]; ///< Состояние генератора (не все нули).
+
+    /**
+     * @brief Конструктор: состояние заполняется генератором SplitMix64 из зерна.
+     * @param seed Начальное значение.
+     */
+    Xoshiro256StarStar(uint64_t seed = 1u) {
+        uint64_t x = seed;
+        for (int k = 0; k < 4; ++k) s[k] = splitmix64(x);
+    }
+
+    /// Циклический сдвиг 64-битного числа влево.
+    static constexpr uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+    /**
+     * @brief Генерация следующего 64-битного псевдослучайного числа.
+     * @return Следующее значение в последовательности.
+     */
+    inline uint64_t next64() {
+        const uint64_t result = rotl(s[1] * 5u, 7) * 9u;
+        const uint64_t t = s[1] << 17;
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = rotl(s[3], 45);
+        return result;
+    }
+
+    /**
+     * @brief Генерация следующего 32-битного числа (старшие биты next64()).
+     * @return Следующее значение в последовательности.
+     */
+    inline uint32_t next() { return uint32_t(next64() >> 32); }
+
+    /**
+     * @brief Заполнение буфера очередными значениями последовательности.
+     * @param out Указатель на буфер для записи.
+     * @param n Количество генерируемых значений.
+     */
+    inline void fill(uint32_t *out, size_t n) {
+        Xoshiro256StarStar g = *this;
+        for (size_t i = 0; i < n; ++i) out[i] = g.next();
+        *this = g;
+    }
+
+    /**
+     * @brief Заполнение буфера 64-битными значениями.
+     * @param out Указатель на буфер для записи.
+     * @param n Количество генерируемых значений.
+     */
+    inline void fill64(uint64_t *out, size_t n) {
+        Xoshiro256StarStar g = *this;
+        for (size_t i = 0; i < n; ++i) out[i] = g.next64();
+        *this = g;
+    }
+
+    /**
+     * @brief Прыжок по многочлену: state = P(M) * state.
+     * @param poly Коэффициенты многочлена прыжка (256 бит).
+     */
+    inline void jump_by(const uint64_t (&poly)[4]) {
+        uint64_t t[4] = {0, 0, 0, 0};
+        for (int i = 0; i < 4; ++i)
+            for (int b = 0; b < 64; ++b) {
+                if (poly[i] & (uint64_t(1) << b))
+                    for (int k = 0; k < 4; ++k) t[k] ^= s[k];
+                next64();
+            }
+        for (int k = 0; k < 4; ++k) s[k] = t[k];
+    }
+
+    /**
+     * @brief Продвижение на 2^128 шагов (официальный многочлен прыжка).
+     */
+    inline void jump() {
+        static constexpr uint64_t poly[4] = {0x180ec6d33cfd0abaull, 0xd5a61266f0c9392cull,
+                                             0xa9582618e03fc9aaull, 0x39abdc4529b1661cull};
+        jump_by(poly);
+    }
+
+    /**
+     * @brief Продвижение на 2^192 шагов (официальный многочлен дальнего прыжка).
+     */
+    inline void long_jump() {
+        static constexpr uint64_t poly[4] = {0x76e15d3efefdcbbfull, 0xc5004e441c522fb3ull,
+                                             0x77710069854ee241ull, 0x39109bb02acbe635ull};
+        jump_by(poly);
+    }
+};
+
+/**
+ * @brief Генератор XORShift64* (Марсалья, Винья), 64 бита состояния, 64-битный выход.
+ *
+ * Три сдвига XORShift с последующим умножением на нечётную константу,
+ * которое убирает линейность младших битов. Период 2^64 - 1.
+ * next() возвращает старшие 32 бита очередного 64-битного значения.
+ */
+struct XORShift64Star : BlockApi<XORShift64Star> {
+    uint64_t state; ///< Текущее состояние генератора (не ноль).
+
+    static constexpr uint64_t multiplier = 0x2545F4914F6CDD1Dull; ///< Выходной множитель.
+
+    /**
+     * @brief Конструктор генератора.
+     * @param s Начальное значение состояния; нулевое заменяется значением по умолчанию.
+     */
+    XORShift64Star(uint64_t s = 88172645463325252ull) : state(s ? s : 88172645463325252ull) {}
+
+    /**
+     * @brief Генерация следующего 64-битного псевдослучайного числа.
+     * @return Следующее значение в последовательности.
+     */
+    inline uint64_t next64() {
+        state ^= state >> 12;
+        state ^= state << 25;
+        state ^= state >> 27;
+        return state * multiplier;
+    }
+
+    /**
+     * @brief Генерация следующего 32-битного числа (старшие биты next64()).
+     * @return Следующее значение в последовательности.
+     */
+    inline uint32_t next() { return uint32_t(next64() >> 32); }
+
+    /**
+     * @brief Заполнение буфера очередными значениями последовательности.
+     * @param out Указатель на буфер для записи.
+     * @param n Количество генерируемых значений.
+     */
+    inline void fill(uint32_t *out, size_t n) {
+        XORShift64Star g = *this;
+        for (size_t i = 0; i < n; ++i) out[i] = g.next();
+        *this = g;
+    }
+
+    /**
+     * @brief Заполнение буфера 64-битными значениями.
+     * @param out Указатель на буфер для записи.
+     * @param n Количество генерируемых значений.
+     */
+    inline void fill64(uint64_t *out, size_t n) {
+        XORShift64Star g = *this;
+        for (size_t i = 0; i < n; ++i) out[i] = g.next64();
+        *this = g;
+    }
+};
+
+/**
+ * @brief Генератор MWC64X (Томас): умножение с переносом, упакованное в одно 64-битное слово.
+ *
+ * Состояние — пара (перенос c, значение x) в старших и младших 32 битах;
+ * шаг — одно 64-битное умножение x * a + c. Модуль a * 2^32 - 1 — безопасное
+ * простое, период около 2^63. Выход — x ^ c (32 бита), поэтому next64()
+ * (из BlockApi) собирается из двух шагов.
+ */
+struct MWC64X : BlockApi<MWC64X> {
+    uint64_t state; ///< Перенос (старшие 32 бита) и значение (младшие 32 бита).
+
+    static constexpr uint64_t a = 4294883355ull; ///< Множитель.
+
+    /**
+     * @brief Конструктор генератора.
+     * @param s Начальное состояние (перенос в старших 32 битах).
+     */
+    MWC64X(uint64_t s = 0x853c49e6748fea9bull) : state(s) {}
+
+    /**
+     * @brief Генерация следующего псевдослучайного числа.
+     * @return Следующее значение в последовательности.
+     */
+    inline uint32_t next() {
+        uint32_t c = uint32_t(state >> 32), x = uint32_t(state);
+        state = x * a + c;
+        return x ^ c;
+    }
+
+    /**
+     * @brief Заполнение буфера очередными значениями последовательности.
+     * @param out Указатель на буфер для записи.
+     * @param n Количество генерируемых значений.
+     */
+    inline void fill(uint32_t *out, size_t n) {
+        MWC64X g = *this;
+        for (size_t i = 0; i < n; ++i) out[i] = g.next();
+        *this = g;
+    }
+};
+
+/**
+ * @brief 64-битный мультипликативный LCG (Lehmer64) со 128-битным состоянием.
+ *
+ * X_{n+1} = a * X_n (mod 2^128), выход — старшие 64 бита X_{n+1}.
+ * Шаг — одно 128-битное умножение (на x86-64 — mul и два imul).
+ * Состояние нечётно, период 2^126.
+ */
+struct LCG64 : BlockApi<LCG64> {
+    unsigned __int128 state; ///< Текущее состояние генератора (нечётное).
+
+    static constexpr uint64_t a = 0xda942042e4dd58b5ull; ///< Множитель.
+
+    /**
+     * @brief Конструктор: состояние заполняется генератором SplitMix64 из зерна.
+     * @param seed Начальное значение.
+     */
+    LCG64(uint64_t seed = 1u) {
+        uint64_t x = seed;
+        uint64_t hi = splitmix64(x);
+        state = ((unsigned __int128)hi << 64 | splitmix64(x)) | 1u;
+    }
+
+    /**
+     * @brief Генерация следующего 64-битного псевдослучайного числа.
+     * @return Следующее значение в последовательности.
+     */
+    inline uint64_t next64() {
+        state *= a;
+        return uint64_t(state >> 64);
+    }
+
+    /**
+     * @brief Генерация следующего 32-битного числа (старшие биты next64()).
+     * @return Следующее значение в последовательности.
+     */
+    inline uint32_t next() { return uint32_t(next64() >> 32); }
+
+    /**
+     * @brief Продвижение генератора на k шагов: state *= a^k (mod 2^128).
+     * @param k Количество шагов.
+     */
+    inline void discard(uint64_t k) {
+        unsigned __int128 r = 1, b = a;
+        for (; k; k >>= 1, b *= b)
+            if (k & 1) r *= b;
+        state *= r;
+    }
+
+    /**
+     * @brief Заполнение буфера очередными значениями последовательности.
+     * @param out Указатель на буфер для записи.
+     * @param n Количество генерируемых значений.
+     */
+    inline void fill(uint32_t *out, size_t n) {
+        LCG64 g = *this;
+        for (size_t i = 0; i < n; ++i) out[i] = g.next();
+        *this = g;
+    }
+
+    /**
+     * @brief Заполнение буфера 64-битными значениями.
+     * @param out Указатель на буфер для записи.
+     * @param n Количество генерируемых значений.
+     */
+    inline void fill64(uint64_t *out, size_t n) {
+        LCG64 g = *this;
+        for (size_t i = 0; i < n; ++i) out[i] = g.next64();
+        *this = g;
+    }
+};
+
+/**
+ * @brief Счётчиковый генератор Philox4x32-10 (Салмон и др., Random123).
+ *
+ * Блок i из четырёх 32-битных значений — чистая функция ключа и номера блока:
+ * счётчик (i mod 2^32, i / 2^32, stream mod 2^32, stream / 2^32) проходит
+ * 10 раундов умножения с перемешиванием. Поэтому любой участок выходной
+ * последовательности вычисляется независимо (fill_range) и без прыжков.
+ */
+struct Philox4x32 : BlockApi<Philox4x32> {
+    uint32_t key[2];   ///< Ключ (зерно).
+    uint64_t stream;   ///< Номер потока (старшие слова счётчика).
+    uint64_t position; ///< Номер следующего выдаваемого значения.
+    uint32_t cache[4]; ///< Последний вычисленный блок (для next()).
+    uint64_t cache_block = ~0ull; ///< Номер блока в cache.
+
+    static constexpr uint32_t M0 = 0xD2511F53u; ///< Множитель первой пары слов.
+    static constexpr uint32_t M1 = 0xCD9E8D57u; ///< Множитель второй пары слов.
+    static constexpr uint32_t W0 = 0x9E3779B9u; ///< Приращение первого слова ключа.
+    static constexpr uint32_t W1 = 0xBB67AE85u; ///< Приращение второго слова ключа.
+    static constexpr int rounds = 10;           ///< Количество раундов.
+
+    /**
+     * @brief Конструктор генератора.
+     * @param seed Ключ (64 бита).
+     * @param s Номер потока.
+     */
+    Philox4x32(uint64_t seed = 0u, uint64_t s = 0u)
+        : key{uint32_t(seed), uint32_t(seed >> 32)}, stream(s), position(0) {}
+
+    /**
+     * @brief Вычисление блока по ключу и счётчику.
+     * @param k Ключ.
+     * @param ctr Счётчик (на входе) и результат (на выходе).
+     */
+    static constexpr void bijection(const uint32_t (&k)[2], uint32_t (&ctr)[4]) {
+        uint32_t k0 = k[0], k1 = k[1];
+        for (int r = 0; r < rounds; ++r) {
+            uint64_t p0 = uint64_t(M0) * ctr[0];
+            uint64_t p1 = uint64_t(M1) * ctr[2];
+            uint32_t c0 = uint32_t(p1 >> 32) ^ ctr[1] ^ k0;
+            uint32_t c1 = uint32_t(p1);
+            uint32_t c2 = uint32_t(p0 >> 32) ^ ctr[3] ^ k1;
+            uint32_t c3 = uint32_t(p0);
+            ctr[0] = c0; ctr[1] = c1; ctr[2] = c2; ctr[3] = c3;
+            k0 += W0;
+            k1 += W1;
+        }
+    }
+
+    /**
+     * @brief Вычисление блока с номером i текущего потока.
+     * @param i Номер блока.
+     * @param out Буфер для четырёх значений.
+     */
+    inline void block(uint64_t i, uint32_t *out) const {
+        uint32_t ctr[4] = {uint32_t(i), uint32_t(i >> 32), uint32_t(stream), uint32_t(stream >> 32)};
+        bijection(key, ctr);
+        for (int w = 0; w < 4; ++w) out[w] = ctr[w];
+    }
+
+#if defined(__AVX2__)
+    /**
+     * @brief Вычисление 8 последовательных блоков начиная с first (AVX2).
+     *
+     * Слова счётчиков хранятся по дорожкам (структура массивов), старшая
+     * половина произведения 32x32 собирается из чётных и нечётных vpmuludq.
+     * Результат транспонируется в порядок значений: out[4 * j + w].
+     * @param first Номер первого блока.
+     * @param out Буфер для 32 значений.
+     */
+    inline void block8(uint64_t first, uint32_t *out) const {
+        const __m256i idx = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+        __m256i c0 = _mm256_add_epi32(_mm256_set1_epi32((int)uint32_t(first)), idx);
+        // Перенос в старшее слово для дорожек, где младшее слово переполнилось.
+        __m256i wrap = _mm256_cmpgt_epi32(_mm256_xor_si256(_mm256_set1_epi32((int)uint32_t(first)), _mm256_set1_epi32(INT32_MIN)),
+                                          _mm256_xor_si256(c0, _mm256_set1_epi32(INT32_MIN)));
+        __m256i c1 = _mm256_sub_epi32(_mm256_set1_epi32((int)uint32_t(first >> 32)), wrap);
+        __m256i c2 = _mm256_set1_epi32((int)uint32_t(stream));
+        __m256i c3 = _mm256_set1_epi32((int)uint32_t(stream >> 32));
+        const __m256i m0 = _mm256_set1_epi32((int)M0), m1 = _mm256_set1_epi32((int)M1);
+        uint32_t k0 = key[0], k1 = key[1];
+        for (int r = 0; r < rounds; ++r) {
+            __m256i lo0 = _mm256_mullo_epi32(c0, m0);
+            __m256i lo1 = _mm256_mullo_epi32(c2, m1);
+            __m256i hi0 = _mm256_blend_epi32(_mm256_srli_epi64(_mm256_mul_epu32(c0, m0), 32),
+                                             _mm256_mul_epu32(_mm256_srli_epi64(c0, 32), m0), 0xAA);
+            __m256i hi1 = _mm256_blend_epi32(_mm256_srli_epi64(_mm256_mul_epu32(c2, m1), 32),
+                                             _mm256_mul_epu32(_mm256_srli_epi64(c2, 32), m1), 0xAA);
+            __m256i n0 = _mm256_xor_si256(_mm256_xor_si256(hi1, c1), _mm256_set1_epi32((int)k0));
+            __m256i n2 = _mm256_xor_si256(_mm256_xor_si256(hi0, c3), _mm256_set1_epi32((int)k1));
+            c0 = n0; c1 = lo1; c2 = n2; c3 = lo0;
+            k0 += W0;
+            k1 += W1;
+        }
+        __m256i t0 = _mm256_unpacklo_epi32(c0, c1), t1 = _mm256_unpackhi_epi32(c0, c1);
+        __m256i t2 = _mm256_unpacklo_epi32(c2, c3), t3 = _mm256_unpackhi_epi32(c2, c3);
+        __m256i u0 = _mm256_unpacklo_epi64(t0, t2), u1 = _mm256_unpackhi_epi64(t0, t2);
+        __m256i u2 = _mm256_unpacklo_epi64(t1, t3), u3 = _mm256_unpackhi_epi64(t1, t3);
+        _mm256_storeu_si256((__m256i *)(out + 0), _mm256_permute2x128_si256(u0, u1, 0x20));
+        _mm256_storeu_si256((__m256i *)(out + 8), _mm256_permute2x128_si256(u2, u3, 0x20));
+        _mm256_storeu_si256((__m256i *)(out + 16), _mm256_permute2x128_si256(u0, u1, 0x31));
+        _mm256_storeu_si256((__m256i *)(out + 24), _mm256_permute2x128_si256(u2, u3, 0x31));
+    }
+#endif
+
+    /**
+     * @brief Заполнение буфера значениями с номерами first_index .. first_index + n - 1.
+     *
+     * Не зависит от текущей позиции и не изменяет генератор, поэтому разные
+     * потоки могут заполнять разные участки одного буфера без синхронизации.
+     * @param out Указатель на буфер для записи.
+     * @param first_index Номер первого значения в потоке.
+     * @param n Количество значений.
+     */
+    inline void fill_range(uint32_t *out, uint64_t first_index, size_t n) const {
+        uint32_t tmp[4];
+        uint64_t i = first_index;
+        const uint64_t end = first_index + n;
+        if (i % 4) {
+            block(i / 4, tmp);
+            for (; i % 4 && i < end; ++i) *out++ = tmp[i % 4];
+        }
+#if defined(__AVX2__)
+        for (; i + 32 <= end; i += 32, out += 32) block8(i / 4, out);
+#endif
+        for (; i + 4 <= end; i += 4, out += 4) block(i / 4, out);
+        if (i < end) {
+            block(i / 4, tmp);
+            for (; i < end; ++i) *out++ = tmp[i % 4];
+        }
+    }
+
+    /**
+     * @brief Генерация следующего псевдослучайного числа.
+     * @return Следующее значение в последовательности.
+     */
+    inline uint32_t next() {
+        uint64_t b = position / 4;
+        if (b != cache_block) {
+            block(b, cache);
+            cache_block = b;
+        }
+        return cache[position++ % 4];
+    }
+
+    /**
+     * @brief Заполнение буфера очередными значениями последовательности.
+     * @param out Указатель на буфер для записи.
+     * @param n Количество генерируемых значений.
+     */
+    inline void fill(uint32_t *out, size_t n) {
+        fill_range(out, position, n);
+        position += n;
+    }
+
+    /**
+     * @brief Пропуск k значений последовательности (O(1)).
+     * @param k Количество пропускаемых значений.
+     */
+    inline void discard(uint64_t k) { position += k; }
+};
+
+/**
+ * @brief Генератор на основе потокового шифра ChaCha (Бернштейн) с R раундами.
+ *
+ * Блок i из 16 32-битных слов — результат функции ChaCha от ключа (256 бит),
+ * 64-битного номера блока i и 64-битного номера потока (nonce). Как и у
+ * Philox4x32, любой участок последовательности вычисляется независимо.
+ * @tparam R Количество раундов (8, 12 или 20).
+ */
+template <int R>
+struct ChaCha : BlockApi<ChaCha<R>> {
+    static_assert(R > 0 && R % 2 == 0, "ChaCha round count must be a positive even number");
+
+    uint32_t key[8];   ///< Ключ.
+    uint64_t stream;   ///< Номер потока (nonce).
+    uint64_t position; ///< Номер следующего выдаваемого значения.
+    uint32_t cache[16]; ///< Последний вычисленный блок (для next()).
+    uint64_t cache_block = ~0ull; ///< Номер блока в cache.
+
+    static constexpr int rounds = R; ///< Количество раундов.
+
+    /**
+     * @brief Конструктор: ключ заполняется генератором SplitMix64 из зерна.
+     * @param seed Начальное значение.
+     * @param s Номер потока.
+     */
+    ChaCha(uint64_t seed = 0u, uint64_t s = 0u) : stream(s), position(0) {
+        uint64_t x = seed;
+        for (int i = 0; i < 8; i += 2) {
+            uint64_t v = splitmix64(x);
+            key[i] = uint32_t(v);
+            key[i + 1] = uint32_t(v >> 32);
+        }
+    }
+
+    /**
+     * @brief Конструктор с явным ключом.
+     * @param k Ключ (8 слов).
+     * @param s Номер потока.
+     */
+    ChaCha(const uint32_t (&k)[8], uint64_t s) : stream(s), position(0) {
+        for (int i = 0; i < 8; ++i) key[i] = k[i];
+    }
+
+    /// Циклический сдвиг 32-битного числа влево.
+    static constexpr uint32_t rotl(uint32_t x, int k) { return (x << k) | (x >> (32 - k)); }
+
+    /// Четвертьраунд ChaCha над словами a, b, c, d.
+    static constexpr void quarter(uint32_t &a, uint32_t &b, uint32_t &c, uint32_t &d) {
+        a += b; d ^= a; d = rotl(d, 16);
+        c += d; b ^= c; b = rotl(b, 12);
+        a += b; d ^= a; d = rotl(d, 8);
+        c += d; b ^= c; b = rotl(b, 7);
+    }
+
+    /**
+     * @brief Вычисление блока с номером i.
+     * @param i Номер блока.
+     * @param out Буфер для 16 значений.
+     */
+    inline void block(uint64_t i, uint32_t *out) const {
+        uint32_t in[16] = {0x61707865u, 0x3320646eu, 0x79622d32u, 0x6b206574u,
+                           key[0], key[1], key[2], key[3], key[4], key[5], key[6], key[7],
+                           uint32_t(i), uint32_t(i >> 32), uint32_t(stream), uint32_t(stream >> 32)};
+        uint32_t x[16];
+        for (int w = 0; w < 16; ++w) x[w] = in[w];
+        for (int r = 0; r < R; r += 2) {
+            quarter(x[0], x[4], x[8], x[12]);
+            quarter(x[1], x[5], x[9], x[13]);
+            quarter(x[2], x[6], x[10], x[14]);
+            quarter(x[3], x[7], x[11], x[15]);
+            quarter(x[0], x[5], x[10], x[15]);
+            quarter(x[1], x[6], x[11], x[12]);
+            quarter(x[2], x[7], x[8], x[13]);
+            quarter(x[3], x[4], x[9], x[14]);
+        }
+        for (int w = 0; w < 16; ++w) out[w] = x[w] + in[w];
+    }
+
+#if defined(__AVX2__)
+    /// Циклический сдвиг всех 32-битных дорожек влево на K бит.
+    template <int K>
+    static inline __m256i rotl8x32(__m256i v) {
+        if constexpr (K == 16) {
+            const __m256i m = _mm256_setr_epi8(2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14, 15, 12, 13,
+                                               2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14, 15, 12, 13);
+            return _mm256_shuffle_epi8(v, m);
+        } else if constexpr (K == 8) {
+            const __m256i m = _mm256_setr_epi8(3, 0, 1, 2, 7, 4, 5, 6, 11, 8, 9, 10, 15, 12, 13, 14,
+                                               3, 0, 1, 2, 7, 4, 5, 6, 11, 8, 9, 10, 15, 12, 13, 14);
+            return _mm256_shuffle_epi8(v, m);
+        } else {
+            return _mm256_or_si256(_mm256_slli_epi32(v, K), _mm256_srli_epi32(v, 32 - K));
+        }
+    }
+
+    /// Векторный четвертьраунд над восемью блоками.
+    static inline void quarter8(__m256i &a, __m256i &b, __m256i &c, __m256i &d) {
+        a = _mm256_add_epi32(a, b); d = rotl8x32<16>(_mm256_xor_si256(d, a));
+        c = _mm256_add_epi32(c, d); b = rotl8x32<12>(_mm256_xor_si256(b, c));
+        a = _mm256_add_epi32(a, b); d = rotl8x32<8>(_mm256_xor_si256(d, a));
+        c = _mm256_add_epi32(c, d); b = rotl8x32<7>(_mm256_xor_si256(b, c));
+    }
+
+    /// Транспонирование матрицы 8x8 из 32-битных слов: v[j][i] <- v[i][j].
+    static inline void transpose8(__m256i (&v)[8]) {
+        __m256i t[8], u[8];
+        for (int i = 0; i < 8; i += 2) {
+            t[i] = _mm256_unpacklo_epi32(v[i], v[i + 1]);
+            t[i + 1] = _mm256_unpackhi_epi32(v[i], v[i + 1]);
+        }
+        for (int i = 0; i < 8; i += 4) {
+            u[i] = _mm256_unpacklo_epi64(t[i], t[i + 2]);
+            u[i + 1] = _mm256_unpackhi_epi64(t[i], t[i + 2]);
+            u[i + 2] = _mm256_unpacklo_epi64(t[i + 1], t[i + 3]);
+            u[i + 3] = _mm256_unpackhi_epi64(t[i + 1], t[i + 3]);
+        }
+        for (int i = 0; i < 4; ++i) {
+            v[i] = _mm256_permute2x128_si256(u[i], u[i + 4], 0x20);
+            v[i + 4] = _mm256_permute2x128_si256(u[i], u[i + 4], 0x31);
+        }
+    }
+
+    /**
+     * @brief Вычисление 8 последовательных блоков начиная с first (AVX2).
+     *
+     * Дорожка j всех 16 векторов — слова блока first + j; после раундов
+     * две матрицы 8x8 транспонируются в порядок значений: out[16 * j + w].
+     * @param first Номер первого блока.
+     * @param out Буфер для 128 значений.
+     */
+    inline void block8(uint64_t first, uint32_t *out) const {
+        const __m256i idx = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+        const __m256i bias = _mm256_set1_epi32(INT32_MIN);
+        __m256i in[16];
+        in[0] = _mm256_set1_epi32(0x61707865);
+        in[1] = _mm256_set1_epi32(0x3320646e);
+        in[2] = _mm256_set1_epi32(0x79622d32);
+        in[3] = _mm256_set1_epi32(0x6b206574);
+        for (int w = 0; w < 8; ++w) in[4 + w] = _mm256_set1_epi32((int)key[w]);
+        __m256i lo = _mm256_set1_epi32((int)uint32_t(first));
+        in[12] = _mm256_add_epi32(lo, idx);
+        // Перенос в старшее слово для дорожек, где младшее слово переполнилось.
+        __m256i wrap = _mm256_cmpgt_epi32(_mm256_xor_si256(lo, bias), _mm256_xor_si256(in[12], bias));
+        in[13] = _mm256_sub_epi32(_mm256_set1_epi32((int)uint32_t(first >> 32)), wrap);
+        in[14] = _mm256_set1_epi32((int)uint32_t(stream));
+        in[15] = _mm256_set1_epi32((int)uint32_t(stream >> 32));
+
+        __m256i x[16];
+        for (int w = 0; w < 16; ++w) x[w] = in[w];
+        for (int r = 0; r < R; r += 2) {
+            quarter8(x[0], x[4], x[8], x[12]);
+            quarter8(x[1], x[5], x[9], x[13]);
+            quarter8(x[2], x[6], x[10], x[14]);
+            quarter8(x[3], x[7], x[11], x[15]);
+            quarter8(x[0], x[5], x[10], x[15]);
+            quarter8(x[1], x[6], x[11], x[12]);
+            quarter8(x[2], x[7], x[8], x[13]);
+            quarter8(x[3], x[4], x[9], x[14]);
+        }
+        __m256i a[8], b[8];
+        for (int w = 0; w < 8; ++w) {
+            a[w] = _mm256_add_epi32(x[w], in[w]);
+            b[w] = _mm256_add_epi32(x[w + 8], in[w + 8]);
+        }
+        transpose8(a);
+        transpose8(b);
+        for (int j = 0; j < 8; ++j) {
+            _mm256_storeu_si256((__m256i *)(out + 16 * j), a[j]);
+            _mm256_storeu_si256((__m256i *)(out + 16 * j + 8), b[j]);
+        }
+    }
+#endif
+
+    /**
+     * @brief Заполнение буфера значениями с номерами first_index .. first_index + n - 1.
+     *
+     * Не зависит от текущей позиции и не изменяет генератор.
+     * @param out Указатель на буфер для записи.
+     * @param first_index Номер первого значения в потоке.
+     * @param n Количество значений.
+     */
+    inline void fill_range(uint32_t *out, uint64_t first_index, size_t n) const {
+        uint32_t tmp[16];
+        uint64_t i = first_index;
+        const uint64_t end = first_index + n;
+        if (i % 16) {
+            block(i / 16, tmp);
+            for (; i % 16 && i < end; ++i) *out++ = tmp[i % 16];
+        }
+#if defined(__AVX2__)
+        for (; i + 128 <= end; i += 128, out += 128) block8(i / 16, out);
+#endif
+        for (; i + 16 <= end; i += 16, out += 16) block(i / 16, out);
+        if (i < end) {
+            block(i / 16, tmp);
+            for (; i < end; ++i) *out++ = tmp[i % 16];
+        }
+    }
+
+    /**
+     * @brief Генерация следующего псевдослучайного числа.
+     * @return Следующее значение в последовательности.
+     */
+    inline uint32_t next() {
+        uint64_t b = position / 16;
+        if (b != cache_block) {
+            block(b, cache);
+            cache_block = b;
+        }
+        return cache[position++ % 16];
+    }
+
+    /**
+     * @brief Заполнение буфера очередными значениями последовательности.
+     * @param out Указатель на буфер для записи.
+     * @param n Количество генерируемых значений.
+     */
+    inline void fill(uint32_t *out, size_t n) {
+        fill_range(out, position, n);
+        position += n;
+    }
+
+    /**
+     * @brief Пропуск k значений последовательности (O(1)).
+     * @param k Количество пропускаемых значений.
+     */
+    inline void discard(uint64_t k) { position += k; }
+};
+
+using ChaCha8 = ChaCha<8>;   ///< ChaCha с 8 раундами.
+using ChaCha12 = ChaCha<12>; ///< ChaCha с 12 раундами.
+using ChaCha20 = ChaCha<20>; ///< ChaCha с 20 раундами.
+
+/**
+ * @brief SIMD-ориентированный вихрь Мерсенна SFMT19937 (Сайто, Мацумото).
+ *
+ * Состояние — 156 128-битных слов (624 32-битных). Рекурсия работает над
+ * целыми 128-битными словами (сдвиги всего слова на байт и сдвиги 32-битных
+ * частей), поэтому весь блок состояния пересчитывается в SSE2-регистрах
+ * за один проход. Период 2^19937 - 1. Выход — слова состояния по порядку.
+ */
+struct SFMT19937 : BlockApi<SFMT19937> {
+    static constexpr int N = 156;    ///< Количество 128-битных слов состояния.
+    static constexpr int N32 = N * 4; ///< Количество 32-битных слов состояния.
+    static constexpr int POS1 = 122; ///< Смещение второго слова рекурсии.
+    static constexpr int SL1 = 18;   ///< Сдвиг 32-битных частей влево.
+    static constexpr int SL2 = 1;    ///< Сдвиг 128-битного слова влево (в байтах).
+    static constexpr int SR1 = 11;   ///< Сдвиг 32-битных частей вправо.
+    static constexpr int SR2 = 1;    ///< Сдвиг 128-битного слова вправо (в байтах).
+    static constexpr uint32_t MSK[4] = {0xdfffffefu, 0xddfecb7fu, 0xbffaffffu, 0xbffffff6u}; ///< Маска.
+    static constexpr uint32_t PARITY[4] = {0x00000001u, 0x00000000u, 0x00000000u, 0x13c9e684u}; ///< Вектор чётности.
+
+    alignas(16) uint32_t state[N32]; ///< Состояние (блок выходных значений).
+    int idx;                         ///< Индекс следующего выдаваемого слова.
+
+    /**
+     * @brief Конструктор генератора (init_gen_rand из эталонной реализации).
+     * @param seed Начальное значение.
+     */
+    SFMT19937(uint32_t seed = 1234u) {
+        state[0] = seed;
+        for (int i = 1; i < N32; ++i)
+            state[i] = 1812433253u * (state[i - 1] ^ (state[i - 1] >> 30)) + uint32_t(i);
+        idx = N32;
+        certify_period();
+    }
+
+    /**
+     * @brief Гарантия полного периода: при необходимости меняется один бит состояния.
+     */
+    inline void certify_period() {
+        uint32_t inner = 0;
+        for (int i = 0; i < 4; ++i) inner ^= state[i] & PARITY[i];
+        for (int i = 16; i > 0; i >>= 1) inner ^= inner >> i;
+        if (inner & 1u) return;
+        for (int i = 0; i < 4; ++i)
+            for (int j = 0; j < 32; ++j)
+                if (PARITY[i] & (1u << j)) {
+                    state[i] ^= 1u << j;
+                    return;
+                }
+    }
+
+#if defined(__SSE2__)
+    /// Рекурсия SFMT над 128-битными словами a, b, c, d.
+    static inline __m128i recursion(__m128i a, __m128i b, __m128i c, __m128i d, __m128i mask) {
+        __m128i y = _mm_and_si128(_mm_srli_epi32(b, SR1), mask);
+        __m128i z = _mm_xor_si128(_mm_srli_si128(c, SR2), a);
+        z = _mm_xor_si128(z, _mm_slli_epi32(d, SL1));
+        z = _mm_xor_si128(z, _mm_slli_si128(a, SL2));
+        return _mm_xor_si128(z, y);
+    }
+
+    /**
+     * @brief Пересчёт всего блока состояния в SSE2-регистрах.
+     */
+    inline void generate_all() {
+        __m128i *s = (__m128i *)state;
+        const __m128i mask = _mm_setr_epi32((int)MSK[0], (int)MSK[1], (int)MSK[2], (int)MSK[3]);
+        __m128i r1 = _mm_load_si128(s + N - 2);
+        __m128i r2 = _mm_load_si128(s + N - 1);
+        int i = 0;
+        for (; i < N - POS1; ++i) {
+            __m128i r = recursion(_mm_load_si128(s + i), _mm_load_si128(s + i + POS1), r1, r2, mask);
+            _mm_store_si128(s + i, r);
+            r1 = r2;
+            r2 = r;
+        }
+        for (; i < N; ++i) {
+            __m128i r = recursion(_mm_load_si128(s + i), _mm_load_si128(s + i + POS1 - N), r1, r2, mask);
+            _mm_store_si128(s + i, r);
+            r1 = r2;
+            r2 = r;
+        }
+    }
+#else
+    /// Рекурсия SFMT над 128-битными словами (скалярная реализация).
+    static inline void recursion(uint32_t *r, const uint32_t *a, const uint32_t *b, const uint32_t *c,
+                                 const uint32_t *d) {
+        uint64_t ah = (uint64_t(a[3]) << 32) | a[2], al = (uint64_t(a[1]) << 32) | a[0];
+        uint64_t ch = (uint64_t(c[3]) << 32) | c[2], cl = (uint64_t(c[1]) << 32) | c[0];
+        uint64_t xh = (ah << (SL2 * 8)) | (al >> (64 - SL2 * 8)), xl = al << (SL2 * 8);
+        uint64_t yh = ch >> (SR2 * 8), yl = (cl >> (SR2 * 8)) | (ch << (64 - SR2 * 8));
+        uint32_t x[4] = {uint32_t(xl), uint32_t(xl >> 32), uint32_t(xh), uint32_t(xh >> 32)};
+        uint32_t y[4] = {uint32_t(yl), uint32_t(yl >> 32), uint32_t(yh), uint32_t(yh >> 32)};
+        for (int k = 0; k < 4; ++k)
+            r[k] = a[k] ^ x[k] ^ ((b[k] >> SR1) & MSK[k]) ^ y[k] ^ (d[k] << SL1);
+    }
+
+    /**
+     * @brief Пересчёт всего блока состояния.
+     */
+    inline void generate_all() {
+        const uint32_t *r1 = state + 4 * (N - 2);
+        const uint32_t *r2 = state + 4 * (N - 1);
+        for (int i = 0; i < N; ++i) {
+            const uint32_t *b = state + 4 * (i < N - POS1 ? i + POS1 : i + POS1 - N);
+            recursion(state + 4 * i, state + 4 * i, b, r1, r2);
+            r1 = r2;
+            r2 = state + 4 * i;
+        }
+    }
+#endif
+
+    /**
+     * @brief Генерация следующего псевдослучайного числа.
+     * @return Следующее значение в последовательности.
+     */
+    inline uint32_t next() {
+        if (idx >= N32) {
+            generate_all();
+            idx = 0;
+        }
+        return state[idx++];
+    }
+
+    /**
+     * @brief Заполнение буфера очередными значениями последовательности.
+     *
+     * Значения копируются из блока состояния целиком; блок пересчитывается
+     * по исчерпании.
+     * @param out Указатель на буфер для записи.
+     * @param n Количество генерируемых значений.
+     */
+    inline void fill(uint32_t *out, size_t n) {
+        while (n) {
+            if (idx >= N32) {
+                generate_all();
+                idx = 0;
+            }
+            size_t m = size_t(N32 - idx) < n ? size_t(N32 - idx) : n;
+            memcpy(out, state + idx, m * sizeof(uint32_t));
+            idx += int(m);
+            out += m;
+            n -= m;
+        }
+    }
+};
+
+/**
+ * @brief Наибольшее число значений в текстовом представлении движка (operator<<).
+ *
+ * Стандарт задаёт состав представления: n слов у mersenne_twister_engine,
+ * r слов и перенос у subtract_with_carry_engine и т. д. Реализация может
+ * добавить позицию в буфере слов (libstdc++ так делает для обоих), поэтому
+ * для них предусмотрено одно значение сверх стандарта.
+ */
+template <class E>
+struct std_engine_values;
+
+template <class U, U a, U c, U m>
+struct std_engine_values<std::linear_congruential_engine<U, a, c, m>> {
+    static constexpr size_t value = 1;
+};
+
+template <class U, size_t w, size_t n, size_t m, size_t r, U a, size_t u, U d, size_t s, U b, size_t t, U c,
+          size_t l, U f>
+struct std_engine_values<std::mersenne_twister_engine<U, w, n, m, r, a, u, d, s, b, t, c, l, f>> {
+    static constexpr size_t value = n + 1;
+};
+
+template <class U, size_t w, size_t s, size_t r>
+struct std_engine_values<std::subtract_with_carry_engine<U, w, s, r>> {
+    static constexpr size_t value = r + 2;
+};
+
+template <class E, size_t p, size_t r>
+struct std_engine_values<std::discard_block_engine<E, p, r>> {
+    static constexpr size_t value = std_engine_values<E>::value + 1;
+};
+
+template <class E, size_t k>
+struct std_engine_values<std::shuffle_order_engine<E, k>> {
+    static constexpr size_t value = std_engine_values<E>::value + k + 1;
+};
+
+/**
+ * @brief Адаптер движка стандартной библиотеки к интерфейсу генераторов.
+ *
+ * Движки с полным 32-битным выходом (std::mt19937) используются напрямую.
+ * Для остальных (std::minstd_rand — [1, 2^31 - 2], std::ranlux24 — 24 бита,
+ * std::knuth_b) 32-битные слова собираются из нескольких выходов через
+ * std::independent_bits_engine, чтобы тесты видели равномерные 32-битные значения.
+ *
+ * Контрольная точка хранит не образ объекта (его размер и раскладка зависят
+ * от стандартной библиотеки: std::mt19937 в libstdc++ занимает 5000 байт),
+ * а значения текстового представления движка как 32-битные слова: число
+ * значений, затем сами значения, дополненные нулями до state_values.
+ * Для std::mt19937 это 2504 байта. У independent_bits_engine нет своего
+ * состояния, его представление совпадает с представлением движка.
+ * @tparam Engine Тип движка из <random>.
+ */
+template <class Engine>
+struct StdEngine : BlockApi<StdEngine<Engine>> {
+    /// Движок обеспечивает полные 32-битные слова без преобразования.
+    static constexpr bool full_range = Engine::min() == 0 && Engine::max() == 0xFFFFFFFFu;
+
+    /// Фактический источник 32-битных слов.
+    using Source = std::conditional_t<full_range, Engine, std::independent_bits_engine<Engine, 32, uint32_t>>;
+
+    Source engine; ///< Обёрнутый движок.
+
+    /**
+     * @brief Конструктор генератора.
+     * @param seed Начальное значение движка.
+     */
+    StdEngine(uint32_t seed = uint32_t(Engine::default_seed)) : engine(seed) {}
+
+    static_assert(Engine::max() <= 0xFFFFFFFFu, "state values must fit in 32-bit words");
+
+    /// Наибольшее число значений состояния.
+    static constexpr size_t state_values = std_engine_values<Engine>::value;
+
+    /// Размер сохранённого состояния: число значений и state_values слов.
+    static constexpr size_t state_size = (state_values + 1) * sizeof(uint32_t);
+
+    /**
+     * @brief Запись состояния в буфер размером state_size.
+     * @param out Буфер для записи.
+     */
+    void save_state(void *out) const {
+        std::ostringstream text;
+        text << engine;
+        std::istringstream in(text.str());
+        uint32_t words[state_values + 1] = {};
+        unsigned long long v;
+        while (words[0] < state_values && in >> v) words[++words[0]] = uint32_t(v);
+        memcpy(out, words, sizeof(words));
+    }
+
+    /**
+     * @brief Восстановление состояния, записанного save_state().
+     * @param in Буфер размером state_size.
+     */
+    void load_state(const void *in) {
+        uint32_t words[state_values + 1];
+        memcpy(words, in, sizeof(words));
+        std::ostringstream text;
+        for (uint32_t i = 1; i <= words[0] && i <= state_values; ++i) text << words[i] << ' ';
+        std::istringstream src(text.str());
+        src >> engine;
+    }
+
+    /**
+     * @brief Генерация следующего псевдослучайного числа.
+     * @return Следующее значение в последовательности.
+     */
+    inline uint32_t next() { return uint32_t(engine()); }
+
+    /**
+     * @brief Заполнение буфера очередными значениями последовательности.
+     * @param out Указатель на буфер для записи.
+     * @param n Количество генерируемых значений.
+     */
+    inline void fill(uint32_t *out, size_t n) {
+        for (size_t i = 0; i < n; ++i) out[i] = uint32_t(engine());
+    }
+};
+
+/**
+ * @brief Требования к генератору, который может тестироваться общим кодом.
+ *
+ * Генератор должен выдавать 32-битные значения по одному (next()) и блоком (fill()).
+ */
+template <class G>
+concept RandomGenerator = requires(G &g, uint32_t *out, size_t n) {
+    { g.next() } -> std::same_as<uint32_t>;
+    g.fill(out, n);
+};
+
+/**
+ * @brief Требования к генератору с 64-битным выходом.
+ *
+ * Генератор должен выдавать 64-битные значения по одному (next64()) и блоком (fill64()).
+ */
+template <class G>
+concept RandomGenerator64 = requires(G &g, uint64_t *out, size_t n) {
+    { g.next64() } -> std::same_as<uint64_t>;
+    g.fill64(out, n);
+};
+
+/**
+ * @brief Требования к генератору чисел с плавающей точкой на [0, 1).
+ */
+template <class G>
+concept UniformRealGenerator = requires(G &g, double *d, float *f, size_t n) {
+    g.fill_double(d, n);
+    g.fill_float(f, n);
+};
+
+/**
+ * @brief Требования к генератору целых чисел из [0, k).
+ */
+template <class G>
+concept BoundedGenerator = requires(G &g, uint32_t *out, size_t n, uint32_t k) {
+    g.fill_bounded(out, n, k);
+};
+
+static_assert(RandomGenerator<LCG<>>);
+static_assert(RandomGenerator<XORShift32>);
+static_assert(RandomGenerator<MWC>);
+static_assert(RandomGenerator<PCG32>);
+static_assert(RandomGenerator<Xoshiro128StarStar>);
+static_assert(RandomGenerator<Xoshiro256StarStar>);
+static_assert(RandomGenerator<XORShift64Star>);
+static_assert(RandomGenerator<MWC64X>);
+static_assert(RandomGenerator<LCG64>);
+static_assert(RandomGenerator<Philox4x32>);
+static_assert(RandomGenerator<ChaCha20>);
+static_assert(RandomGenerator<SFMT19937>);
+static_assert(RandomGenerator<StdEngine<std::minstd_rand>>);
+static_assert(RandomGenerator<StdEngine<std::mt19937>>);
+static_assert(RandomGenerator<StdEngine<std::ranlux24>>);
+static_assert(RandomGenerator<StdEngine<std::knuth_b>>);
+
+static_assert(RandomGenerator64<LCG<>>);
+static_assert(RandomGenerator64<XORShift32>);
+static_assert(RandomGenerator64<MWC>);
+static_assert(RandomGenerator64<PCG32>);
+static_assert(RandomGenerator64<Xoshiro128StarStar>);
+static_assert(RandomGenerator64<Xoshiro256StarStar>);
+static_assert(RandomGenerator64<XORShift64Star>);
+static_assert(RandomGenerator64<MWC64X>);
+static_assert(RandomGenerator64<LCG64>);
+static_assert(RandomGenerator64<Philox4x32>);
+static_assert(RandomGenerator64<ChaCha20>);
+static_assert(RandomGenerator64<SFMT19937>);
+static_assert(RandomGenerator64<StdEngine<std::mt19937>>);
+
+static_assert(UniformRealGenerator<LCG<>>);
+static_assert(UniformRealGenerator<XORShift32>);
+static_assert(UniformRealGenerator<MWC>);
+static_assert(UniformRealGenerator<PCG32>);
+static_assert(UniformRealGenerator<Xoshiro128StarStar>);
+static_assert(UniformRealGenerator<Xoshiro256StarStar>);
+static_assert(UniformRealGenerator<XORShift64Star>);
+static_assert(UniformRealGenerator<MWC64X>);
+static_assert(UniformRealGenerator<LCG64>);
+static_assert(UniformRealGenerator<Philox4x32>);
+static_assert(UniformRealGenerator<ChaCha20>);
+static_assert(UniformRealGenerator<SFMT19937>);
+static_assert(UniformRealGenerator<StdEngine<std::mt19937>>);
+
+static_assert(BoundedGenerator<LCG<>>);
+static_assert(BoundedGenerator<XORShift32>);
+static_assert(BoundedGenerator<MWC>);
+static_assert(BoundedGenerator<PCG32>);
+static_assert(BoundedGenerator<Xoshiro128StarStar>);
+static_assert(BoundedGenerator<Xoshiro256StarStar>);
+static_assert(BoundedGenerator<XORShift64Star>);
+static_assert(BoundedGenerator<MWC64X>);
+static_assert(BoundedGenerator<LCG64>);
+static_assert(BoundedGenerator<Philox4x32>);
+static_assert(BoundedGenerator<ChaCha20>);
+static_assert(BoundedGenerator<SFMT19937>);
+static_assert(BoundedGenerator<StdEngine<std::mt19937>>);
+
 #endif // GENERATORS_H
@@ -1,163 +1,713 @@
 #include <cstdio>
 #include <cstdlib>
 #include <cstdint>
+#include <cmath>
+#include <chrono>
 #include <ctime>
+#include <cstring>
+#include <utility>
 #include "generators.h"
 #include "stats.h"
+#include "registry.h"
+#include "period.h"
+#include "distributions.h"
+#include "sweep.h"
+
+/// Массив размеров выборок, которые будут протестированы.
+static const int sample_sizes[] = {1000, 2000, 5000, 10000, 15000, 20000, 25000, 30000, 35000, 40000, 45000, 50000, 55000, 60000,
+70000, 75000, 80000, 85000, 90000, 100000};
+
+/// Количество повторов тестирования для одной размерности.
+static const int num_samples = 10;
+
+/// Диапазон значений для оценки распределения.
+static const unsigned long long int range = (1ull << 32);
+
+/// Количество интервалов (bins) для гистограммы в тесте хи-квадрат.
+static const int bins = 1000;
 
 /**
- * @brief Главная функция программы.
+ * @brief Усреднённые по num_samples повторам результаты тестов на одном размере выборки.
+ */
+struct SuiteResult {
+    double m = 0, s = 0, cv = 0, chi2 = 0, monobit = 0, block_frequency = 0, runs = 0, cumulative_sums = 0, serial2 = 0;
+    double time_ms = 0; ///< Суммарное время генерации (без расчёта статистик).
+};
+
+/**
+ * @brief Прогон набора тестов для одного генератора на одном размере выборки.
  *
- * Проводит статистический анализ последовательностей чисел, сгенерированных разными ГСЧ (LCG, XORShift, MWC),
- * с использованием тестов, таких как среднее значение, стандартное отклонение, коэффициент вариации,
- * критерий хи-квадрат и тесты из NIST.
+ * Шаблон инстанцируется для каждого типа генератора, поэтому генерация
+ * (gen.fill) встраивается в цикл без косвенных вызовов.
+ * В time_ms попадает только время генерации: время расчёта статистик
+ * накапливается отдельно и вычитается.
  *
- * @return 0 при успешном завершении программы.
+ * @tparam Word uint32_t (gen.fill) или uint64_t (gen.fill64, тесты на 64-битных словах).
+ * @tparam Gen Тип генератора, удовлетворяющий RandomGenerator.
+ * @param gen Генератор; продолжает свою последовательность.
+ * @param sample_size Размер выборки (в словах Word).
+ * @return Средние значения тестов по num_samples повторам.
  */
-int main() {
-    /// Массив размеров выборок, которые будут протестированы.
-    const int sample_sizes[] = {1000, 2000, 5000, 10000, 15000, 20000, 25000, 30000, 35000, 40000, 45000, 50000, 55000, 60000,
-    70000, 75000, 80000, 85000, 90000, 100000};
+template <class Word = uint32_t, RandomGenerator Gen>
+SuiteResult measure_suite(Gen &gen, int sample_size) {
+    SuiteResult r;
+    double m_i, s_i, cv_i;
 
-    /// Количество повторов тестирования для одной размерности.
-    const int num_samples = 10;
-    int sample_size;
+    /// Временные метки для измерения времени выполнения.
+    clock_t t1, t2, t3, t4, stats_time = 0;
 
-    /// Диапазон значений для оценки распределения.
-    const unsigned long long int range = (1ul << 32);
+    t1 = clock();
+    for (int i = 0; i < num_samples; ++i) {
+        Word buffer[sample_size];
 
-    /// Количество интервалов (bins) для гистограммы в тесте хи-квадрат.
-    const int bins = 1000;
+        // Генерация последовательности.
+        if constexpr (sizeof(Word) == 8) gen.fill64(buffer, sample_size);
+        else gen.fill(buffer, sample_size);
 
-    // Переменные для хранения результатов тестов.
-    double m = 0, s = 0, cv = 0, chi2 = 0, monobit = 0, block_frequency = 0, runs = 0, cumulative_sums = 0, serial2 = 0;
-    double m_i, s_i, cv_i;
+        t3 = clock();
 
-    /// Временные метки для измерения времени выполнения.
-    clock_t t1, t2, t3, t4;
+        // Расчет статистик.
+        m_i = mean(buffer, sample_size);
+        s_i = stdev(buffer, sample_size, m_i);
+        cv_i = coeff_var(m_i, s_i);
 
-    /// Заголовок таблицы результатов.
-    printf("Generator type  |       Mean     |      STDdev     |   CV   |     chi2      | monobit | block freq |  runs  | cumulative sums  | serial2 |   time\n");
+        r.m += m_i; r.s += s_i; r.cv += cv_i;
+        if constexpr (sizeof(Word) == 8) r.chi2 += chi_squared(buffer, sample_size, bins);
+        else r.chi2 += chi_squared(buffer, sample_size, bins, range);
+        r.monobit += nist_monobit(buffer, sample_size);
+        r.block_frequency += nist_block_frequency(buffer, sample_size, 128);
+        r.runs += nist_runs(buffer, sample_size);
+        r.cumulative_sums += nist_cumulative_sums(buffer, sample_size);
+        r.serial2 += nist_serial2(buffer, sample_size);
+        t4 = clock();
+        stats_time += t4 - t3;
+    }
+    t2 = clock();
 
-    /**
-     * @brief Тестирование генератора LCG (Linear Congruential Generator).
-     */
-    LCG lcg(1234);
+    r.m /= num_samples; r.s /= num_samples; r.cv /= num_samples; r.chi2 /= num_samples;
+    r.monobit /= num_samples; r.block_frequency /= num_samples; r.runs /= num_samples;
+    r.cumulative_sums /= num_samples; r.serial2 /= num_samples;
+    r.time_ms = 1000.0 * (t2 - t1 - stats_time) / CLOCKS_PER_SEC;
+    return r;
+}
+
+/**
+ * @brief Вывод строки таблицы результатов.
+ * @param label Левый столбец (имя генератора и размер выборки).
+ * @param r Результаты тестов.
+ */
+void print_result(const char *label, const SuiteResult &r) {
+    printf("%s| %.2f  |  %.2f  | %.3f  | %-12.2f  |  %.2f   |    %.2f    |  %.2f  |      %.2f        |  %.2f   | %-6.2f ms\n",
+            label, r.m, r.s, r.cv, r.chi2, r.monobit, r.block_frequency, r.runs, r.cumulative_sums, r.serial2, r.time_ms);
+}
+
+/**
+ * @brief Прогон набора тестов для одного генератора по всем размерам выборок.
+ *
+ * @tparam Word Тип слова выборки (см. measure_suite).
+ * @tparam Gen Тип генератора, удовлетворяющий RandomGenerator.
+ * @param name Имя генератора для вывода (до 12 символов).
+ * @param gen Генератор; продолжает последовательность между размерами выборок.
+ */
+template <class Word = uint32_t, RandomGenerator Gen>
+void run_suite(const char *name, Gen &gen) {
+    char label[32];
     for (int ss = 0; ss < 20; ss++){
-        t1 = clock();
-        for (int i = 0; i < num_samples; ++i) {
-            sample_size = sample_sizes[ss];
-            uint32_t buffer[sample_size];
-
-            // Генерация последовательности.
-            for (int j = 0; j < sample_size; ++j)
-                buffer[j] = lcg.next();
-
-            t3 = clock();
-
-            // Расчет статистик.
-            m_i = mean(buffer, sample_size);
-            s_i = stdev(buffer, sample_size, m_i);
-            cv_i = coeff_var(m_i, s_i);
-
-            m += m_i; s += s_i; cv += cv_i;
-            chi2 += chi_squared(buffer, sample_size, bins, range);
-            monobit += nist_monobit(buffer, sample_size);
-            block_frequency += nist_block_frequency(buffer, sample_size, 128);
-            runs += nist_runs(buffer, sample_size);
-            cumulative_sums += nist_cumulative_sums(buffer, sample_size);
-            serial2 += nist_serial2(buffer, sample_size);
-            t4 = clock();
-        }
-        t2 = clock();
+        SuiteResult r = measure_suite<Word>(gen, sample_sizes[ss]);
+        snprintf(label, sizeof(label), "%-12s %-7d", name, sample_sizes[ss]);
+        print_result(label, r);
+    }
+}
 
-        /// Вывод результатов для LCG.
-        printf("LCG      %-7d| %.2f  |  %.2f  | %.3f  | %-12.2f  |  %.2f   |    %.2f    |  %.2f  |      %.2f        |  %.2f   | %-6.2f ms\n",
-                sample_sizes[ss], m / num_samples, s / num_samples, cv / num_samples, chi2 / num_samples,
-                monobit / num_samples, block_frequency / num_samples, runs / num_samples, cumulative_sums / num_samples, serial2 / num_samples,
-                1000.0*(t2 - t1 - (t4 - t3)) / CLOCKS_PER_SEC);
+/// Размер выборки для пакетного прогона семейства LCG.
+static const int family_sample_size = 20000;
 
-        // Сброс накопленных значений.
-        m = 0; s = 0; cv = 0; chi2 = 0; monobit = 0; block_frequency = 0; runs = 0; cumulative_sums = 0; serial2 = 0;
+/**
+ * @brief Прогон набора тестов для I-го варианта семейства LCG.
+ */
+template <size_t I>
+void run_lcg_family_member() {
+    LCGFamily<I> gen(1234);
+    char label[32];
+    snprintf(label, sizeof(label), "%-10u %-10u ", gen.a, gen.c);
+    print_result(label, measure_suite(gen, family_sample_size));
+}
+
+/**
+ * @brief Пакетный прогон набора тестов по всем вариантам семейства LCG<A, C>.
+ *
+ * Каждый вариант — отдельный тип со своими константами, поэтому его
+ * цикл генерации специализируется компилятором.
+ */
+template <size_t... I>
+void run_lcg_family(std::index_sequence<I...>) {
+    printf("Multiplier Increment  |       Mean     |      STDdev     |   CV   |     chi2      | monobit | block freq |  runs  | cumulative sums  | serial2 |   time\n");
+    (run_lcg_family_member<I>(), ...);
+}
+
+/**
+ * @brief Проверка периода генератора с 32-битным состоянием и вывод отчёта.
+ *
+ * Если часть состояний лежит вне цикла зерна, выводятся число коротких
+ * циклов и самые длинные из них с наименьшим состоянием каждого.
+ * @tparam Gen Генератор с 32-битным состоянием и discard().
+ * @param name Имя генератора для вывода.
+ * @param seed Проверяемое зерно.
+ * @param max_period Максимально возможный период генератора.
+ */
+template <JumpableGenerator32 Gen>
+void run_period_check(const char *name, uint32_t seed, uint64_t max_period) {
+    clock_t t1 = clock();
+    PeriodReport r = certify_period<Gen>(seed);
+    clock_t t2 = clock();
+    printf("%-8s seed %-10u | cycle %-10llu %-7s | fixed points %llu",
+           name, seed, (unsigned long long)r.cycle_length, r.cycle_length == max_period ? "(max)" : "(short)",
+           (unsigned long long)r.fixed_points);
+    if (r.fixed_points) printf(" (first %u)", r.first_fixed_point);
+    printf(" | states on other cycles %llu | %.2f s CPU\n", (unsigned long long)r.other_states,
+           double(t2 - t1) / CLOCKS_PER_SEC);
+    if (!r.other_states) return;
+    printf("%-8s %llu short cycles", name, (unsigned long long)r.short_cycles);
+    if (r.unaccounted) printf(", %llu states off cycles", (unsigned long long)r.unaccounted);
+    printf("; longest %zu (length @ smallest state):", r.cycles.size());
+    for (size_t i = 0; i < r.cycles.size(); ++i)
+        printf("%s %llu @ %u", i % 8 ? "," : "\n        ", (unsigned long long)r.cycles[i].length,
+               r.cycles[i].representative);
+    printf("\n");
+}
+
+/**
+ * @brief Поиск цикла MWC для набора зёрен и вывод результата.
+ *
+ * Проверяются зерно из набора тестов, зерно по умолчанию и вырожденные
+ * зёрна: (0, 0), неподвижная точка (a - 1, 2^32 - 1) и перенос не меньше a.
+ */
+void run_mwc_cycles() {
+    const uint64_t budget = 1ull << 28;
+    const uint64_t seeds[] = {13579ull, 88172645463325252ull, 0ull,
+                              (uint64_t(MWC::a - 1) << 32) | 0xFFFFFFFFull, 0xFFFFFFFFFFFFFFFFull};
+    for (uint64_t seed : seeds) {
+        clock_t t1 = clock();
+        CycleInfo c = find_mwc_cycle(seed, budget);
+        clock_t t2 = clock();
+        if (c.found)
+            printf("MWC      seed %016llx | tail %-10llu | cycle %-10llu | %.2f s CPU\n", (unsigned long long)seed,
+                   (unsigned long long)c.tail, (unsigned long long)c.length, double(t2 - t1) / CLOCKS_PER_SEC);
+        else
+            printf("MWC      seed %016llx | no cycle within %llu steps | %.2f s CPU\n", (unsigned long long)seed,
+                   (unsigned long long)budget, double(t2 - t1) / CLOCKS_PER_SEC);
     }
+}
+
+/// Размер выборки для проверки fill_double() / fill_float().
+static const int uniform_sample_size = 1 << 20;
+
+/**
+ * @brief Проверка равномерных чисел на [0, 1): среднее, отклонение и время заполнения.
+ *
+ * Ожидаемые значения: среднее 0.5, стандартное отклонение 1/sqrt(12) = 0.2887.
+ * @tparam Gen Генератор с fill_double() и fill_float().
+ * @param name Имя генератора для вывода.
+ * @param gen Генератор.
+ */
+template <UniformRealGenerator Gen>
+void run_uniform(const char *name, Gen &gen) {
+    std::unique_ptr<double[]> d(new double[uniform_sample_size]);
+    std::unique_ptr<float[]> f(new float[uniform_sample_size]);
 
-    /**
-     * @brief Тестирование генератора XORShift32.
-     */
+    clock_t t1 = clock();
+    gen.fill_double(d.get(), uniform_sample_size);
+    clock_t t2 = clock();
+    gen.fill_float(f.get(), uniform_sample_size);
+    clock_t t3 = clock();
+
+    double md = mean(d.get(), uniform_sample_size);
+    double sd = stdev(d.get(), uniform_sample_size, md);
+    for (int i = 0; i < uniform_sample_size; ++i) d[i] = f[i];
+    double mf = mean(d.get(), uniform_sample_size);
+    double sf = stdev(d.get(), uniform_sample_size, mf);
+
+    printf("%-12s | %-11.5f | %-8.5f | %-8.2f ms | %-10.5f | %-8.5f | %-8.2f ms\n", name, md, sd,
+           1000.0 * (t2 - t1) / CLOCKS_PER_SEC, mf, sf, 1000.0 * (t3 - t2) / CLOCKS_PER_SEC);
+}
+
+/**
+ * @brief Проверка fill_double() / fill_float() для всех генераторов из generators.h.
+ */
+void run_uniforms() {
+    printf("Generator    | double mean | stdev    | time        | float mean | stdev    | time\n");
+    LCG lcg(1234);
+    run_uniform("LCG", lcg);
     XORShift32 xor32(9876);
-    for (int ss = 0; ss < 20; ss++){
-        t1 = clock();
-        for (int i = 0; i < num_samples; ++i) {
-            sample_size = sample_sizes[ss];
-            uint32_t buffer[sample_size];
-
-            for (int j = 0; j < sample_size; ++j)
-                buffer[j] = xor32.next();
-
-            t3 = clock();
-
-            m_i = mean(buffer, sample_size);
-            s_i = stdev(buffer, sample_size, m_i);
-            cv_i = coeff_var(m_i, s_i);
-
-            m += m_i; s += s_i; cv += cv_i;
-            chi2 += chi_squared(buffer, sample_size, bins, range);
-            monobit += nist_monobit(buffer, sample_size);
-            block_frequency += nist_block_frequency(buffer, sample_size, 128);
-            runs += nist_runs(buffer, sample_size);
-            cumulative_sums += nist_cumulative_sums(buffer, sample_size);
-            serial2 += nist_serial2(buffer, sample_size);
-            t4 = clock();
+    run_uniform("XORShift", xor32);
+    MWC mwc(13579);
+    run_uniform("MWC", mwc);
+    PCG32 pcg(1234);
+    run_uniform("PCG32", pcg);
+    PCG32x8 pcg8(1234);
+    run_uniform("PCG32x8", pcg8);
+    Xoshiro128StarStar xo128(1234);
+    run_uniform("xoshiro128", xo128);
+    Xoshiro256StarStar xo256(1234);
+    run_uniform("xoshiro256", xo256);
+    XORShift64Star xor64;
+    run_uniform("XORShift64*", xor64);
+    MWC64X mwc64;
+    run_uniform("MWC64X", mwc64);
+    LCG64 lcg64(1234);
+    run_uniform("LCG64", lcg64);
+    Philox4x32 philox(1234);
+    run_uniform("Philox4x32", philox);
+    ChaCha20 chacha(1234);
+    run_uniform("ChaCha20", chacha);
+    SFMT19937 sfmt(1234);
+    run_uniform("SFMT19937", sfmt);
+    StdEngine<std::mt19937> mt(1234);
+    run_uniform("mt19937", mt);
+}
+
+/// Размер выборки для проверки fill_bounded().
+static const int bounded_sample_size = 1 << 22;
+
+/// Проверяемые границы диапазона: малые k и k около 2^31 и 3 * 2^30, где
+/// смещение остатка next() % k максимально.
+static const uint32_t bounded_ks[] = {6, 10, 52, 100, 1000, 1000000, 2147483649u, 3221225472u};
+
+/**
+ * @brief Проверка fill_bounded(): хи-квадрат и время против смещённого next() % k.
+ *
+ * Для k <= bins корзина соответствует одному значению, иначе корзины
+ * покрывают почти равные участки [0, k). Ожидаемое значение хи-квадрат
+ * равно числу корзин минус один.
+ * @tparam Gen Генератор с fill_bounded().
+ * @param name Имя генератора для вывода.
+ * @param gen Генератор.
+ */
+template <BoundedGenerator Gen>
+void run_bounded(const char *name, Gen &gen) {
+    std::unique_ptr<uint32_t[]> buf(new uint32_t[bounded_sample_size]);
+    for (uint32_t k : bounded_ks) {
+        int nb = k < (uint32_t)bins ? (int)k : bins;
+
+        clock_t t1 = clock();
+        gen.fill_bounded(buf.get(), bounded_sample_size, k);
+        clock_t t2 = clock();
+        double chi2 = chi_squared(buf.get(), bounded_sample_size, nb, k);
+
+        clock_t t3 = clock();
+        for (int i = 0; i < bounded_sample_size; ++i) buf[i] = gen.next() % k;
+        clock_t t4 = clock();
+        double chi2_mod = chi_squared(buf.get(), bounded_sample_size, nb, k);
+
+        printf("%-12s %-10u | %-4d | %-12.2f | %-8.2f ms | %-14.2f | %-8.2f ms\n", name, k, nb, chi2,
+               1000.0 * (t2 - t1) / CLOCKS_PER_SEC, chi2_mod, 1000.0 * (t4 - t3) / CLOCKS_PER_SEC);
+    }
+}
+
+/**
+ * @brief Проверка fill_bounded() на исходных генераторах и PCG32.
+ */
+void run_boundeds() {
+    printf("Generator    k          | bins | chi2         | time        | chi2 next()%%k  | time\n");
+    LCG lcg(1234);
+    run_bounded("LCG", lcg);
+    XORShift32 xor32(9876);
+    run_bounded("XORShift", xor32);
+    MWC mwc(13579);
+    run_bounded("MWC", mwc);
+    PCG32 pcg(1234);
+    run_bounded("PCG32", pcg);
+}
+
+/// Размер выборки для проверки распределений зиккурата.
+static const int ziggurat_sample_size = 1 << 22;
+
+/**
+ * @brief Доля значений выборки, больших bound по модулю.
+ */
+static double tail_fraction(const double *x, int n, double bound) {
+    int count = 0;
+    for (int i = 0; i < n; ++i) count += std::fabs(x[i]) > bound;
+    return double(count) / n;
+}
+
+/**
+ * @brief Проверка fill_normal() / fill_exponential(): моменты, доля хвоста и время.
+ *
+ * Ожидаемые значения: N(0, 1) — среднее 0, отклонение 1, доля |x| > r
+ * 5.76e-4; Exp(1) — среднее 1, отклонение 1, доля x > r 4.54e-4.
+ * @tparam Gen Тип генератора, удовлетворяющий RandomGenerator.
+ * @param name Имя генератора для вывода.
+ * @param gen Генератор.
+ */
+template <RandomGenerator Gen>
+void run_ziggurat(const char *name, Gen &gen) {
+    std::unique_ptr<double[]> x(new double[ziggurat_sample_size]());
+
+    clock_t t1 = clock();
+    fill_normal(gen, x.get(), ziggurat_sample_size);
+    clock_t t2 = clock();
+    double mn = mean(x.get(), ziggurat_sample_size);
+    double sn = stdev(x.get(), ziggurat_sample_size, mn);
+    double tn = tail_fraction(x.get(), ziggurat_sample_size, ziggurat_normal_r);
+
+    clock_t t3 = clock();
+    fill_exponential(gen, x.get(), ziggurat_sample_size);
+    clock_t t4 = clock();
+    double me = mean(x.get(), ziggurat_sample_size);
+    double se = stdev(x.get(), ziggurat_sample_size, me);
+    double te = tail_fraction(x.get(), ziggurat_sample_size, ziggurat_exponential_r);
+
+    printf("%-12s | %-8.5f | %-7.5f | %.2e | %-8.2f ms | %-8.5f | %-7.5f | %.2e | %-8.2f ms\n", name, mn, sn, tn,
+           1000.0 * (t2 - t1) / CLOCKS_PER_SEC, me, se, te, 1000.0 * (t4 - t3) / CLOCKS_PER_SEC);
+}
+
+/**
+ * @brief Проверка распределений зиккурата на нескольких генераторах.
+ */
+void run_ziggurats() {
+    printf("Generator    | N mean   | N sdev  | N tail   | time        | E mean   | E sdev  | E tail   | time\n");
+    LCG lcg(1234);
+    run_ziggurat("LCG", lcg);
+    XORShift32 xor32(9876);
+    run_ziggurat("XORShift", xor32);
+    MWC mwc(13579);
+    run_ziggurat("MWC", mwc);
+    PCG32 pcg(1234);
+    run_ziggurat("PCG32", pcg);
+    PCG32x8 pcg8(1234);
+    run_ziggurat("PCG32x8", pcg8);
+    Xoshiro256StarStar xo256(1234);
+    run_ziggurat("xoshiro256", xo256);
+    SFMT19937 sfmt(1234);
+    run_ziggurat("SFMT19937", sfmt);
+}
+
+/// Количество шагов XORShift32Sliced в проверке битовых плоскостей (2^20 бит на плоскость).
+static const size_t bitslice_steps = 4096;
+
+/**
+ * @brief Битовые тесты NIST по каждому разряду XORShift32 на плоскостях XORShift32Sliced.
+ *
+ * Плоскость разряда j — биты j всех 256 потоков за bitslice_steps шагов;
+ * тесты получают её как массив uint64_t без транспонирования. Для
+ * сравнения выводится время выдачи того же числа значений XORShift32x8.
+ */
+void run_bitsliced() {
+    const size_t words = 4 * bitslice_steps;
+    std::unique_ptr<uint64_t[]> planes(new uint64_t[32 * words]());
+    std::unique_ptr<uint32_t[]> values(new uint32_t[XORShift32Sliced::streams * bitslice_steps]());
+
+    XORShift32Sliced sliced(9876);
+    clock_t t1 = clock();
+    sliced.fill_bitplanes(planes.get(), bitslice_steps);
+    clock_t t2 = clock();
+    XORShift32x8 lanes(9876);
+    lanes.fill(values.get(), XORShift32Sliced::streams * bitslice_steps);
+    clock_t t3 = clock();
+    printf("bit planes %.2f ms, XORShift32x8 %.2f ms for %zu values\n", 1000.0 * (t2 - t1) / CLOCKS_PER_SEC,
+           1000.0 * (t3 - t2) / CLOCKS_PER_SEC, XORShift32Sliced::streams * bitslice_steps);
+
+    printf("Bit | monobit | block freq |  runs  | cumulative sums  | serial2\n");
+    for (int j = 0; j < 32; ++j) {
+        const uint64_t *p = planes.get() + j * words;
+        printf("%-3d |    %d    |     %d      |   %d    |        %d         |    %d\n", j, nist_monobit(p, words),
+               nist_block_frequency(p, words, 128), nist_runs(p, words), nist_cumulative_sums(p, words),
+               nist_serial2(p, words));
+    }
+}
+
+/// Размер блока длительного прогона.
+static const int long_block_size = 1 << 16;
+
+/// Интервал между контрольными точками длительного прогона (секунды процессорного времени).
+static const double checkpoint_interval = 5.0;
+
+/**
+ * @brief Состояние длительного прогона, сохраняемое в контрольной точке.
+ */
+struct LongRunProgress {
+    uint64_t blocks = 0;     ///< Общее число блоков прогона.
+    uint64_t seed = 0;       ///< Зерно генератора.
+    uint64_t block = 0;      ///< Номер следующего блока.
+    uint64_t passes[5] = {}; ///< Число блоков, прошедших каждый тест NIST.
+    double chi2 = 0;         ///< Сумма хи-квадрат по блокам.
+};
+
+/**
+ * @brief Длительный прогон тестов по блокам с периодическими контрольными точками.
+ *
+ * Если файл контрольной точки для этого генератора существует, прогон
+ * продолжается с сохранённого блока и позиции генератора, так что
+ * результат совпадает с непрерывным прогоном. Точка записывается раз в
+ * checkpoint_interval секунд и в конце. Новый прогон начинается, только
+ * если файла нет: точка другого генератора или прогона (другое число
+ * блоков или зерно), другого формата или повреждённая отвергается с
+ * ошибкой и не перезаписывается.
+ * @param name Имя генератора в реестре.
+ * @param blocks Общее число блоков по long_block_size значений.
+ * @param path Путь к файлу контрольной точки.
+ * @return 0 при успешном завершении, 1 при неизвестном имени, несовпадающей
+ *         контрольной точке или ошибке записи.
+ */
+int run_long(const char *name, uint64_t blocks, const char *path) {
+    const GeneratorEntry *e = find_generator(name);
+    if (!e) {
+        fprintf(stderr, "Unknown generator: %s\n", name);
+        return 1;
+    }
+    std::unique_ptr<BlockGenerator> gen = e->create(e->default_seed);
+    std::unique_ptr<unsigned char[]> state(new unsigned char[gen->state_size()]);
+    std::unique_ptr<uint32_t[]> buf(new uint32_t[long_block_size]);
+
+    LongRunProgress p;
+    p.blocks = blocks;
+    p.seed = e->default_seed;
+    LongRunProgress saved;
+    bool missing = false;
+    bool loaded = load_checkpoint(path, e->name, state.get(), gen->state_size(), &saved, sizeof(saved), &missing);
+    if (!loaded && !missing) {
+        fprintf(stderr, "Checkpoint %s is not a valid %s checkpoint (another generator, format or a damaged file); "
+                "remove it or rerun with the same arguments\n", path, e->name);
+        return 1;
+    }
+    if (loaded) {
+        if (saved.blocks != blocks || saved.seed != p.seed || saved.block > saved.blocks) {
+            fprintf(stderr, "Checkpoint %s belongs to a run of %llu blocks with seed %llu (at block %llu); "
+                    "remove it or rerun with the same arguments\n", path, (unsigned long long)saved.blocks,
+                    (unsigned long long)saved.seed, (unsigned long long)saved.block);
+            return 1;
         }
-        t2 = clock();
+        p = saved;
+        gen->load_state(state.get());
+        printf("%s: resumed at block %llu\n", e->name, (unsigned long long)p.block);
+    }
 
-        /// Вывод результатов для XORShift32.
-        printf("XORShift %-7d| %.2f  |  %.2f  | %.3f  | %-12.2f  |  %-.2f   |    %.2f    |  %.2f  |      %.2f        |  %.2f   | %-6.2f ms\n",
-                sample_sizes[ss], m / num_samples, s / num_samples, cv / num_samples, chi2 / num_samples,
-                monobit / num_samples, block_frequency / num_samples, runs / num_samples, cumulative_sums / num_samples, serial2 / num_samples,
-                1000.0*(t2 - t1 - (t4 - t3)) / CLOCKS_PER_SEC);
+    clock_t last = clock(), checkpoint_time = 0;
+    int checkpoints = 0;
+    auto checkpoint = [&]() {
+        clock_t t = clock();
+        gen->save_state(state.get());
+        bool ok = save_checkpoint(path, e->name, state.get(), gen->state_size(), &p, sizeof(p));
+        last = clock();
+        checkpoint_time += last - t;
+        ++checkpoints;
+        if (!ok) fprintf(stderr, "Cannot write checkpoint: %s\n", path);
+        return ok;
+    };
 
-        m = 0; s = 0; cv = 0; chi2 = 0; monobit = 0; block_frequency = 0; runs = 0; cumulative_sums = 0; serial2 = 0;
+    for (; p.block < blocks; ++p.block) {
+        gen->fill(buf.get(), long_block_size);
+        p.chi2 += chi_squared(buf.get(), long_block_size, bins, range);
+        p.passes[0] += nist_monobit(buf.get(), long_block_size);
+        p.passes[1] += nist_block_frequency(buf.get(), long_block_size, 128);
+        p.passes[2] += nist_runs(buf.get(), long_block_size);
+        p.passes[3] += nist_cumulative_sums(buf.get(), long_block_size);
+        p.passes[4] += nist_serial2(buf.get(), long_block_size);
+        if (clock() - last >= checkpoint_interval * CLOCKS_PER_SEC) {
+            ++p.block;
+            bool ok = checkpoint();
+            --p.block;
+            if (!ok) return 1;
+        }
     }
+    if (!checkpoint()) return 1;
 
-    /**
-     * @brief Тестирование генератора MWC (Multiply-With-Carry).
-     */
+    double nb = p.block ? double(p.block) : 1.0;
+    printf("%s: %llu blocks of %d | chi2 %.2f | monobit %.4f | block freq %.4f | runs %.4f | cumulative sums %.4f "
+           "| serial2 %.4f\n",
+           e->name, (unsigned long long)p.block, long_block_size, p.chi2 / nb, p.passes[0] / nb, p.passes[1] / nb,
+           p.passes[2] / nb, p.passes[3] / nb, p.passes[4] / nb);
+    printf("%d checkpoints (%zu bytes of generator state), %.3f ms total\n", checkpoints, gen->state_size(),
+           1000.0 * checkpoint_time / CLOCKS_PER_SEC);
+    return 0;
+}
+
+/**
+ * @brief Проверка диапазона зёрен и вывод ранжированного списка слабых зёрен.
+ * @param name Имя генератора ("LCG", "XORShift" или "MWC").
+ * @param first Первое зерно.
+ * @param count Количество зёрен.
+ * @param top Длина списка.
+ * @return 0 при успешном завершении, 1 при неподдерживаемом имени.
+ */
+int run_sweep(const char *name, uint64_t first, uint64_t count, size_t top) {
+    SweepResult r;
+    auto t1 = std::chrono::steady_clock::now();
+    if (!sweep_generator(name, first, count, top, r)) {
+        fprintf(stderr, "Sweep supports LCG, XORShift and MWC, not %s\n", name);
+        return 1;
+    }
+    double s = std::chrono::duration<double>(std::chrono::steady_clock::now() - t1).count();
+
+    printf("%s: %llu seeds from %llu in %.2f s (%.0f seeds/s, %u threads), %zu values per seed\n", name,
+           (unsigned long long)r.seeds, (unsigned long long)first, s, r.seeds / s, default_threads(),
+           sweep_sample_size);
+    printf("Failed tests:");
+    for (int k = 0; k <= sweep_tests; ++k) printf(" %d: %llu", k, (unsigned long long)r.histogram[k]);
+    printf("\nCandidates %llu, confirmed on %zu values %llu (%.1f expected by chance)\n",
+           (unsigned long long)r.candidates, sweep_confirm_size, (unsigned long long)r.confirmed,
+           r.expected_by_chance());
+    printf("Rank  | Seed                 | failed | chi2 z     | tests\n");
+    for (size_t i = 0; i < r.weakest.size(); ++i) {
+        const SeedScore &w = r.weakest[i];
+        printf("%-5zu | %-20llu | %-6d | %-10.2f |", i + 1, (unsigned long long)w.seed, w.failed, w.chi2_z);
+        for (int t = 0; t < sweep_tests; ++t)
+            if (w.failed_mask & (1u << t)) printf(" %s", sweep_test_names[t]);
+        printf("\n");
+    }
+    return 0;
+}
+
+/**
+ * @brief Прогон набора тестов на 64-битных выборках.
+ *
+ * 32-битные генераторы собирают 64-битное значение из двух выходов,
+ * XORShift64*, LCG64 и xoshiro256** выдают его за один шаг.
+ */
+void run_suites64() {
+    printf("Generator type      |       Mean     |      STDdev     |   CV   |     chi2      | monobit | block freq |  runs  | cumulative sums  | serial2 |   time\n");
+    LCG lcg(1234);
+    run_suite<uint64_t>("LCG", lcg);
+    XORShift32 xor32(9876);
+    run_suite<uint64_t>("XORShift", xor32);
     MWC mwc(13579);
-    for (int ss = 0; ss < 20; ss++){
-        t1 = clock();
-        for (int i = 0; i < num_samples; ++i) {
-            sample_size = sample_sizes[ss];
-            uint32_t buffer[sample_size];
-
-            for (int j = 0; j < sample_size; ++j)
-                buffer[j] = mwc.next();
-
-            t3 = clock();
-
-            m_i = mean(buffer, sample_size);
-            s_i = stdev(buffer, sample_size, m_i);
-            cv_i = coeff_var(m_i, s_i);
-
-            m += m_i; s += s_i; cv += cv_i;
-            chi2 += chi_squared(buffer, sample_size, bins, range);
-            monobit += nist_monobit(buffer, sample_size);
-            block_frequency += nist_block_frequency(buffer, sample_size, 128);
-            runs += nist_runs(buffer, sample_size);
-            cumulative_sums += nist_cumulative_sums(buffer, sample_size);
-            serial2 += nist_serial2(buffer, sample_size);
-            t4 = clock();
+    run_suite<uint64_t>("MWC", mwc);
+    PCG32 pcg(1234);
+    run_suite<uint64_t>("PCG32", pcg);
+    XORShift64Star xor64;
+    run_suite<uint64_t>("XORShift64*", xor64);
+    MWC64X mwc64;
+    run_suite<uint64_t>("MWC64X", mwc64);
+    LCG64 lcg64(1234);
+    run_suite<uint64_t>("LCG64", lcg64);
+    Xoshiro256StarStar xo256(1234);
+    run_suite<uint64_t>("xoshiro256", xo256);
+}
+
+/**
+ * @brief Главная функция программы.
+ *
+ * Проводит статистический анализ последовательностей чисел, сгенерированных разными ГСЧ,
+ * с использованием тестов, таких как среднее значение, стандартное отклонение, коэффициент вариации,
+ * критерий хи-квадрат и тесты из NIST. Без аргументов тестируются все генераторы реестра,
+ * кроме XORShift256, ChaCha8 и ChaCha12 (19 генераторов: от LCG, XORShift и MWC до
+ * движков стандартной библиотеки).
+ *
+ * Если в командной строке заданы имена генераторов, они выбираются из реестра
+ * (registry.h) и тестируются через блочный интерфейс BlockGenerator.
+ * Ключ --lcg-family запускает пакетный прогон семейства LCG<A, C>,
+ * ключ --certify-period — исчерпывающую проверку периода LCG и XORShift32,
+ * ключ --mwc-cycles — поиск циклов MWC методом выделенных точек,
+ * ключ --64 — прогон тестов на 64-битных выборках (next64/fill64),
+ * ключ --uniform — проверка fill_double/fill_float,
+ * ключ --bounded — проверка fill_bounded,
+ * ключ --ziggurat — проверка нормального и экспоненциального распределений,
+ * ключ --bitsliced — битовые тесты по разрядам на плоскостях XORShift32Sliced,
+ * ключ --long ИМЯ БЛОКИ ФАЙЛ — длительный прогон с контрольными точками,
+ * ключ --sweep ИМЯ ПЕРВОЕ КОЛИЧЕСТВО [ДЛИНА] — проверка диапазона зёрен.
+ *
+ * @param argc Количество аргументов.
+ * @param argv Имена генераторов (необязательно).
+ * @return 0 при успешном завершении программы, 1 при неизвестном имени генератора.
+ */
+int main(int argc, char **argv) {
+    if (argc == 2 && strcmp(argv[1], "--lcg-family") == 0) {
+        run_lcg_family(std::make_index_sequence<lcg_family_size>());
+        return 0;
+    }
+    if (argc == 2 && strcmp(argv[1], "--certify-period") == 0) {
+        run_period_check<LCG<>>("LCG", 1234, state_space_32);
+        run_period_check<XORShift32>("XORShift", 9876, XORShift32::period);
+        return 0;
+    }
+    if (argc == 2 && strcmp(argv[1], "--mwc-cycles") == 0) {
+        run_mwc_cycles();
+        return 0;
+    }
+    if (argc == 2 && strcmp(argv[1], "--64") == 0) {
+        run_suites64();
+        return 0;
+    }
+    if (argc == 2 && strcmp(argv[1], "--uniform") == 0) {
+        run_uniforms();
+        return 0;
+    }
+    if (argc == 2 && strcmp(argv[1], "--bounded") == 0) {
+        run_boundeds();
+        return 0;
+    }
+    if (argc == 2 && strcmp(argv[1], "--ziggurat") == 0) {
+        run_ziggurats();
+        return 0;
+    }
+    if (argc == 2 && strcmp(argv[1], "--bitsliced") == 0) {
+        run_bitsliced();
+        return 0;
+    }
+    if (argc == 5 && strcmp(argv[1], "--long") == 0)
+        return run_long(argv[2], strtoull(argv[3], nullptr, 10), argv[4]);
+    if ((argc == 5 || argc == 6) && strcmp(argv[1], "--sweep") == 0)
+        return run_sweep(argv[2], strtoull(argv[3], nullptr, 10), strtoull(argv[4], nullptr, 10),
+                         argc == 6 ? strtoull(argv[5], nullptr, 10) : 20);
+
+    for (int i = 1; i < argc; ++i) {
+        if (!find_generator(argv[i])) {
+            fprintf(stderr, "Unknown generator: %s\n", argv[i]);
+            return 1;
         }
-        t2 = clock();
+    }
 
-        /// Вывод результатов для MWC.
-        printf("MWC      %-7d| %.2f  |  %.2f  | %.3f  | %-12.2f  |  %.2f   |    %.2f    |  %.2f  |      %.2f        |  %.2f   | %-6.2f ms\n",
-                sample_sizes[ss], m / num_samples, s / num_samples, cv / num_samples, chi2 / num_samples,
-                monobit / num_samples, block_frequency / num_samples, runs / num_samples, cumulative_sums / num_samples, serial2 / num_samples,
-                1000.0*(t2 - t1 - (t4 - t3)) / CLOCKS_PER_SEC);
+    /// Заголовок таблицы результатов.
+    printf("Generator type      |       Mean     |      STDdev     |   CV   |     chi2      | monobit | block freq |  runs  | cumulative sums  | serial2 |   time\n");
 
-        m = 0; s = 0; cv = 0; chi2 = 0; monobit = 0; block_frequency = 0; runs = 0; cumulative_sums = 0; serial2 = 0;
+    if (argc > 1) {
+        for (int i = 1; i < argc; ++i) {
+            const GeneratorEntry *e = find_generator(argv[i]);
+            std::unique_ptr<BlockGenerator> gen = e->create(e->default_seed);
+            run_suite(e->name, *gen);
+        }
+        return 0;
     }
 
+    LCG lcg(1234);
+    run_suite("LCG", lcg);
+    XORShift32 xor32(9876);
+    run_suite("XORShift", xor32);
+    MWC mwc(13579);
+    run_suite("MWC", mwc);
+    PCG32 pcg(1234);
+    run_suite("PCG32", pcg);
+    PCG32x8 pcg8(1234);
+    run_suite("PCG32x8", pcg8);
+    Xoshiro128StarStar xo128(1234);
+    run_suite("xoshiro128", xo128);
+    Xoshiro256StarStar xo256(1234);
+    run_suite("xoshiro256", xo256);
+    XORShift64Star xor64;
+    run_suite("XORShift64*", xor64);
+    MWC64X mwc64;
+    run_suite("MWC64X", mwc64);
+    LCG64 lcg64(1234);
+    run_suite("LCG64", lcg64);
+    Xoshiro128x8 xo128x8(1234);
+    run_suite("xoshiro128x8", xo128x8);
+    Xoshiro256x4 xo256x4(1234);
+    run_suite("xoshiro256x4", xo256x4);
+    Philox4x32 philox(1234);
+    run_suite("Philox4x32", philox);
+    ChaCha20 chacha(1234);
+    run_suite("ChaCha20", chacha);
+    SFMT19937 sfmt(1234);
+    run_suite("SFMT19937", sfmt);
+    StdEngine<std::minstd_rand> minstd(1234);
+    run_suite("minstd_rand", minstd);
+    StdEngine<std::mt19937> mt(1234);
+    run_suite("mt19937", mt);
+    StdEngine<std::ranlux24> ranlux(1234);
+    run_suite("ranlux24", ranlux);
+    StdEngine<std::knuth_b> knuth(1234);
+    run_suite("knuth_b", knuth);
+
     return 0;
 }
@@ -0,0 +1,473 @@
+/**
+ * @file period.h
+ * @brief Исследование периода и структуры циклов генераторов.
+ *
+ * Для генераторов с 32-битным состоянием пространство из 2^32 состояний
+ * делится между потоками: каждый поток переходит к своему участку
+ * последовательности через discard() и проходит его обычными шагами.
+ * Если цикл зерна и неподвижные точки покрывают не всё пространство,
+ * остальные циклы перечисляются обходом с битовой картой посещённых состояний.
+ * Для MWC (64-битное состояние) цикл ищется методом выделенных точек.
+ */
+
+#ifndef PERIOD_H
+#define PERIOD_H
+
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <cstdint>
+#include <memory>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+#include "generators.h"
+
+/// Количество состояний 32-битного генератора.
+inline constexpr uint64_t state_space_32 = 1ull << 32;
+
+/**
+ * @brief Генератор с 32-битным состоянием и прыжком вперёд.
+ */
+template <class G>
+concept JumpableGenerator32 = requires(G g, uint64_t k) {
+    G(uint32_t{});
+    { g.state } -> std::convertible_to<uint32_t>;
+    g.next();
+    g.discard(k);
+};
+
+/**
+ * @brief Короткий цикл пространства состояний.
+ */
+struct ShortCycle {
+    uint64_t length;         ///< Длина цикла.
+    uint32_t representative; ///< Наименьшее состояние цикла.
+};
+
+/// Наибольшее количество коротких циклов, перечисляемых в PeriodReport::cycles.
+inline constexpr size_t max_listed_cycles = 64;
+
+/**
+ * @brief Результат проверки периода.
+ */
+struct PeriodReport {
+    uint64_t cycle_length;          ///< Длина цикла, на котором лежит зерно.
+    uint64_t fixed_points;          ///< Количество неподвижных точек во всём пространстве состояний.
+    uint32_t first_fixed_point;     ///< Наименьшая неподвижная точка (если есть).
+    uint64_t other_states;          ///< Состояния вне цикла зерна и не неподвижные.
+    uint64_t short_cycles;          ///< Количество циклов длины не меньше 2 среди other_states.
+    uint64_t unaccounted;           ///< Состояния other_states вне найденных циклов (только если step не биекция).
+    std::vector<ShortCycle> cycles; ///< До max_listed_cycles самых длинных коротких циклов.
+};
+
+/**
+ * @brief Количество потоков по умолчанию.
+ */
+inline unsigned default_threads() {
+    unsigned n = std::thread::hardware_concurrency();
+    return n ? n : 1u;
+}
+
+/**
+ * @brief Атомарное уменьшение значения до min(target, value).
+ */
+inline void atomic_min(std::atomic<uint64_t> &target, uint64_t value) {
+    uint64_t cur = target.load(std::memory_order_relaxed);
+    while (value < cur && !target.compare_exchange_weak(cur, value, std::memory_order_relaxed)) {}
+}
+
+/// Количество независимых проходов внутри одного потока (скрывает задержку шага генератора).
+inline constexpr unsigned walkers_per_thread = 8;
+
+/**
+ * @brief Длина цикла, содержащего состояние seed.
+ *
+ * Позиции 1..2^32 последовательности, начатой из seed, делятся на
+ * threads * walkers_per_thread участков; каждый участок проходится от своей
+ * точки, полученной через discard(), в поисках первого возвращения в seed.
+ * Проходы одного потока чередуются, чтобы шаги разных участков выполнялись
+ * параллельно. Поток завершается, как только все его оставшиеся позиции
+ * лежат дальше уже найденного возвращения.
+ * @tparam Gen Генератор с 32-битным состоянием.
+ * @param seed Начальное состояние.
+ * @param threads Количество потоков.
+ * @return Длина цикла (не больше 2^32).
+ */
+template <JumpableGenerator32 Gen>
+uint64_t cycle_length(uint32_t seed, unsigned threads = default_threads()) {
+    constexpr unsigned W = walkers_per_thread;
+    std::atomic<uint64_t> best(state_space_32 + 1);
+    const uint64_t parts = uint64_t(threads) * W;
+    const uint64_t chunk = (state_space_32 + parts - 1) / parts;
+    std::vector<std::thread> pool;
+
+    for (unsigned t = 0; t < threads; ++t) {
+        pool.emplace_back([&, t] {
+            uint64_t start[W];
+            Gen g[W] = {};
+            for (unsigned w = 0; w < W; ++w) {
+                start[w] = (uint64_t(t) * W + w) * chunk;
+                g[w] = Gen(seed);
+                g[w].discard(start[w]);
+            }
+            for (uint64_t i = 0; i < chunk; ) {
+                if (start[0] + i >= best.load(std::memory_order_relaxed)) return;
+                uint64_t stop = chunk - i < (1u << 16) ? chunk : i + (1u << 16);
+                for (; i < stop; ++i) {
+                    bool hit = false;
+                    for (unsigned w = 0; w < W; ++w) {
+                        g[w].next();
+                        hit |= g[w].state == seed;
+                    }
+                    if (hit) {
+                        for (unsigned w = 0; w < W; ++w)
+                            if (g[w].state == seed && start[w] + i < state_space_32)
+                                atomic_min(best, start[w] + i + 1);
+                    }
+                }
+            }
+        });
+    }
+    for (std::thread &th : pool) th.join();
+    return best.load();
+}
+
+/**
+ * @brief Поиск неподвижных точек (step(x) == x) перебором всех 2^32 состояний.
+ * @tparam Gen Генератор с 32-битным состоянием.
+ * @param first Наименьшая найденная неподвижная точка (не изменяется, если их нет).
+ * @param threads Количество потоков.
+ * @return Количество неподвижных точек.
+ */
+template <JumpableGenerator32 Gen>
+uint64_t count_fixed_points(uint32_t &first, unsigned threads = default_threads()) {
+    std::atomic<uint64_t> count(0), lowest(state_space_32);
+    const uint64_t chunk = (state_space_32 + threads - 1) / threads;
+    std::vector<std::thread> pool;
+
+    for (unsigned t = 0; t < threads; ++t) {
+        pool.emplace_back([&, t] {
+            uint64_t begin = t * chunk;
+            uint64_t end = begin + chunk < state_space_32 ? begin + chunk : state_space_32;
+            uint64_t local = 0;
+            for (uint64_t x = begin; x < end; ++x) {
+                Gen g((uint32_t)x);
+                g.next();
+                local += g.state == uint32_t(x);
+            }
+            if (!local) return;
+            count += local;
+            for (uint64_t x = begin; x < end; ++x) {
+                Gen g((uint32_t)x);
+                g.next();
+                if (g.state == uint32_t(x)) {
+                    atomic_min(lowest, x);
+                    break;
+                }
+            }
+        });
+    }
+    for (std::thread &th : pool) th.join();
+    if (count) first = uint32_t(lowest.load());
+    return count.load();
+}
+
+/**
+ * @brief Битовая карта всех 2^32 состояний (512 МБ) с атомарной установкой битов.
+ */
+struct StateBitmap {
+    std::unique_ptr<std::atomic<uint64_t>[]> words; ///< 2^26 слов по 64 состояния.
+
+    StateBitmap() : words(new std::atomic<uint64_t>[state_space_32 / 64]) {
+        for (uint64_t i = 0; i < state_space_32 / 64; ++i) words[i].store(0, std::memory_order_relaxed);
+    }
+
+    /// Признак посещения состояния x.
+    bool test(uint32_t x) const { return words[x >> 6].load(std::memory_order_relaxed) >> (x & 63) & 1; }
+
+    /// Отметка состояния x.
+    void set(uint32_t x) { words[x >> 6].fetch_or(uint64_t(1) << (x & 63), std::memory_order_relaxed); }
+};
+
+/**
+ * @brief Перечисление циклов вне цикла зерна seed.
+ *
+ * Сначала потоки отмечают в битовой карте цикл зерна (каждый — свой участок
+ * через discard()). Затем пространство делится между потоками; от каждого
+ * неотмеченного состояния x поток идёт по последовательности, отмечая
+ * состояния, пока не вернётся в x, и запоминает длину цикла и его
+ * наименьшее состояние. Два потока могут пройти один цикл одновременно —
+ * дубликаты убираются по наименьшему состоянию. Неподвижные точки уже
+ * посчитаны count_fixed_points() и в список не входят. Перечисление полно
+ * для биекций (все генераторы проекта); если step не биекция, обход
+ * прерывается после other_states шагов, а состояния вне найденных циклов
+ * учитываются в unaccounted.
+ * @tparam Gen Генератор с 32-битным состоянием.
+ * @param seed Начальное состояние.
+ * @param r Отчёт с заполненными cycle_length и other_states; дополняются
+ *          short_cycles, unaccounted и cycles.
+ * @param threads Количество потоков.
+ */
+template <JumpableGenerator32 Gen>
+void find_short_cycles(uint32_t seed, PeriodReport &r, unsigned threads = default_threads()) {
+    StateBitmap seen;
+    std::vector<std::thread> pool;
+    const uint64_t seed_chunk = (r.cycle_length + threads - 1) / threads;
+    for (unsigned t = 0; t < threads; ++t) {
+        pool.emplace_back([&, t] {
+            uint64_t begin = t * seed_chunk;
+            uint64_t end = begin + seed_chunk < r.cycle_length ? begin + seed_chunk : r.cycle_length;
+            if (begin >= end) return;
+            Gen g(seed);
+            g.discard(begin);
+            for (uint64_t i = begin; i < end; ++i, g.next()) seen.set(g.state);
+        });
+    }
+    for (std::thread &th : pool) th.join();
+    pool.clear();
+
+    std::vector<std::vector<ShortCycle>> found(threads);
+    const uint64_t chunk = (state_space_32 + threads - 1) / threads;
+    for (unsigned t = 0; t < threads; ++t) {
+        pool.emplace_back([&, t] {
+            uint64_t begin = t * chunk;
+            uint64_t end = begin + chunk < state_space_32 ? begin + chunk : state_space_32;
+            for (uint64_t x = begin; x < end; ++x) {
+                if (seen.test(uint32_t(x))) continue;
+                Gen g((uint32_t)x);
+                uint32_t lowest = uint32_t(x);
+                uint64_t len = 0;
+                do {
+                    seen.set(g.state);
+                    if (g.state < lowest) lowest = g.state;
+                    g.next();
+                    ++len;
+                } while (g.state != uint32_t(x) && len <= r.other_states);
+                if (g.state != uint32_t(x)) continue;
+                if (len > 1) found[t].push_back({len, lowest});
+            }
+        });
+    }
+    for (std::thread &th : pool) th.join();
+
+    std::vector<ShortCycle> all;
+    for (std::vector<ShortCycle> &f : found) all.insert(all.end(), f.begin(), f.end());
+    std::sort(all.begin(), all.end(),
+              [](const ShortCycle &a, const ShortCycle &b) { return a.representative < b.representative; });
+    all.erase(std::unique(all.begin(), all.end(),
+                          [](const ShortCycle &a, const ShortCycle &b) {
+                              return a.representative == b.representative;
+                          }),
+              all.end());
+
+    uint64_t on_cycles = 0;
+    for (const ShortCycle &c : all) on_cycles += c.length;
+    r.short_cycles = all.size();
+    r.unaccounted = r.other_states - on_cycles;
+    std::sort(all.begin(), all.end(), [](const ShortCycle &a, const ShortCycle &b) {
+        return a.length != b.length ? a.length > b.length : a.representative < b.representative;
+    });
+    if (all.size() > max_listed_cycles) all.resize(max_listed_cycles);
+    r.cycles = std::move(all);
+}
+
+/**
+ * @brief Полная проверка структуры циклов для зерна seed.
+ *
+ * Находит длину цикла зерна и все неподвижные точки. Если остаются другие
+ * состояния, find_short_cycles() перечисляет их циклы: количество, длины
+ * и представителей (до max_listed_cycles самых длинных).
+ * @tparam Gen Генератор с 32-битным состоянием.
+ * @param seed Начальное состояние.
+ * @param threads Количество потоков.
+ * @return Отчёт о структуре циклов.
+ */
+template <JumpableGenerator32 Gen>
+PeriodReport certify_period(uint32_t seed, unsigned threads = default_threads()) {
+    PeriodReport r{};
+    r.cycle_length = cycle_length<Gen>(seed, threads);
+    r.fixed_points = count_fixed_points<Gen>(r.first_fixed_point, threads);
+    uint64_t seed_fixed = r.cycle_length == 1 ? 1 : 0;
+    r.other_states = state_space_32 - r.cycle_length - (r.fixed_points - seed_fixed);
+    if (r.other_states) find_short_cycles<Gen>(seed, r, threads);
+    return r;
+}
+
+/**
+ * @brief Неблокирующая хеш-таблица выделенных точек с открытой адресацией.
+ *
+ * Для каждого ключа хранится наименьшая позиция, на которой он встречен.
+ * Ключи выделенных точек всегда чётны (младшие биты равны нулю), поэтому
+ * в ячейке хранится key | 1, а 0 обозначает пустую ячейку.
+ */
+struct DistinguishedPointTable {
+    size_t mask;                                        ///< Размер таблицы минус 1 (размер — степень двойки).
+    std::unique_ptr<std::atomic<uint64_t>[]> keys;      ///< Ключи (key | 1) или 0.
+    std::unique_ptr<std::atomic<uint64_t>[]> positions; ///< Наименьшие позиции ключей.
+
+    /**
+     * @brief Конструктор пустой таблицы.
+     * @param log2_capacity Логарифм количества ячеек.
+     */
+    explicit DistinguishedPointTable(unsigned log2_capacity)
+        : mask((size_t(1) << log2_capacity) - 1),
+          keys(new std::atomic<uint64_t>[mask + 1]),
+          positions(new std::atomic<uint64_t>[mask + 1]) {
+        for (size_t i = 0; i <= mask; ++i) {
+            keys[i].store(0, std::memory_order_relaxed);
+            positions[i].store(UINT64_MAX, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Добавление ключа с позицией.
+     * @param key Ключ выделенной точки (младший бит равен нулю).
+     * @param pos Позиция в последовательности.
+     * @param previous Наименьшая ранее записанная позиция ключа или UINT64_MAX.
+     * @return false, если таблица переполнена.
+     */
+    bool insert(uint64_t key, uint64_t pos, uint64_t &previous) {
+        const uint64_t tagged = key | 1u;
+        size_t i = size_t((key * 0x9E3779B97F4A7C15ull) >> 20) & mask;
+        for (size_t probe = 0; probe <= mask; ++probe, i = (i + 1) & mask) {
+            uint64_t cur = keys[i].load(std::memory_order_acquire);
+            if (cur == 0) {
+                if (keys[i].compare_exchange_strong(cur, tagged, std::memory_order_acq_rel))
+                    cur = tagged;
+            }
+            if (cur != tagged) continue;
+            previous = positions[i].load(std::memory_order_relaxed);
+            while (pos < previous &&
+                   !positions[i].compare_exchange_weak(previous, pos, std::memory_order_relaxed)) {}
+            return true;
+        }
+        return false;
+    }
+};
+
+/**
+ * @brief Результат поиска цикла.
+ */
+struct CycleInfo {
+    bool found;      ///< Цикл найден в пределах бюджета шагов.
+    uint64_t tail;   ///< Длина предпериода (число шагов до входа в цикл).
+    uint64_t length; ///< Длина цикла.
+};
+
+/**
+ * @brief Упакованное состояние MWC после pos шагов из seed.
+ */
+inline uint64_t mwc_state_at(uint64_t seed, uint64_t pos) {
+    MWC g(seed);
+    g.discard(pos);
+    return (uint64_t(g.carry) << 32) | g.state;
+}
+
+/**
+ * @brief Параллельный поиск цикла MWC методом выделенных точек.
+ *
+ * Позиции последовательности обходятся раундами; внутри раунда каждый поток
+ * переходит к своему участку через MWC::discard(). Состояния, у которых
+ * младшие dp_bits бит равны нулю (выделенные точки), заносятся в общую
+ * неблокирующую таблицу. Повтор ключа на другой позиции означает, что обе
+ * позиции лежат на цикле, а их разность кратна его длине. Циклы короче
+ * участка потока, не содержащие выделенных точек (например, неподвижные
+ * точки), ловятся контрольной точкой Брента внутри потока. НОД разностей
+ * уточняется делением на простые множители с проверкой через discard().
+ * Предпериод находится двоичным поиском. Память ограничена размером таблицы,
+ * число выделенных точек — выбором dp_bits по бюджету шагов.
+ * @param seed Начальное значение в формате MWC(uint64_t).
+ * @param max_steps Бюджет шагов (наибольшая проверяемая позиция).
+ * @param threads Количество потоков.
+ * @param log2_capacity Логарифм размера таблицы выделенных точек.
+ * @return Предпериод и длина цикла либо found == false.
+ */
+inline CycleInfo find_mwc_cycle(uint64_t seed, uint64_t max_steps, unsigned threads = default_threads(),
+                                unsigned log2_capacity = 20) {
+    unsigned dp_bits = 1;
+    while (dp_bits < 63 && (max_steps >> dp_bits) > (uint64_t(1) << (log2_capacity - 1))) ++dp_bits;
+    const uint64_t dp_mask = (uint64_t(1) << dp_bits) - 1;
+
+    DistinguishedPointTable table(log2_capacity);
+    std::atomic<uint64_t> period_multiple(0), cycle_pos(UINT64_MAX);
+    std::atomic<bool> full(false);
+    const uint64_t round = uint64_t(threads) << 24;
+
+    for (uint64_t base = 0; base < max_steps && !period_multiple.load() && !full.load(); base += round) {
+        const uint64_t span = max_steps - base < round ? max_steps - base : round;
+        const uint64_t chunk = (span + threads - 1) / threads;
+        std::vector<std::thread> pool;
+        for (unsigned t = 0; t < threads; ++t) {
+            pool.emplace_back([&, t] {
+                uint64_t pos = base + t * chunk;
+                uint64_t end = pos + chunk < base + span ? pos + chunk : base + span;
+                if (pos >= end) return;
+                auto report = [&](uint64_t first, uint64_t second) {
+                    uint64_t cur = period_multiple.load();
+                    while (!period_multiple.compare_exchange_weak(cur, std::gcd(cur, second - first))) {}
+                    atomic_min(cycle_pos, first);
+                };
+                MWC g(seed);
+                g.discard(pos);
+                // Контрольная точка Брента ловит короткие циклы без выделенных точек.
+                uint64_t saved = (uint64_t(g.carry) << 32) | g.state, saved_pos = pos, power = 1;
+                for (; pos < end; ++pos, g.next()) {
+                    if ((pos & 0xFFFF) == 0 && period_multiple.load(std::memory_order_relaxed)) return;
+                    uint64_t z = (uint64_t(g.carry) << 32) | g.state;
+                    if (power) {
+                        if (z == saved && pos != saved_pos) {
+                            report(saved_pos, pos);
+                            power = 0;
+                        } else if (pos - saved_pos == power) {
+                            saved = z;
+                            saved_pos = pos;
+                            power <<= 1;
+                        }
+                    }
+                    if (z & dp_mask) continue;
+                    uint64_t prev;
+                    if (!table.insert(z, pos, prev)) {
+                        full = true;
+                        return;
+                    }
+                    if (prev == UINT64_MAX || prev == pos) continue;
+                    if (prev < pos) report(prev, pos);
+                    else report(pos, prev);
+                }
+            });
+        }
+        for (std::thread &th : pool) th.join();
+    }
+
+    CycleInfo info{false, 0, 0};
+    uint64_t lambda = period_multiple.load();
+    if (!lambda) return info;
+
+    // Уточнение длины цикла: делим на простые множители, пока повтор сохраняется.
+    const uint64_t x = cycle_pos.load();
+    const uint64_t zx = mwc_state_at(seed, x);
+    uint64_t rest = lambda;
+    for (uint64_t p = 2; p * p <= rest || rest > 1; ++p) {
+        if (p * p > rest) p = rest;
+        if (rest % p) continue;
+        while (rest % p == 0) rest /= p;
+        while (lambda % p == 0 && mwc_state_at(seed, x + lambda / p) == zx) lambda /= p;
+    }
+
+    // Предпериод: наименьшее mu, для которого состояние на позиции mu повторяется через lambda шагов.
+    uint64_t lo = 0, hi = x;
+    while (lo < hi) {
+        uint64_t mid = lo + (hi - lo) / 2;
+        if (mwc_state_at(seed, mid) == mwc_state_at(seed, mid + lambda)) hi = mid;
+        else lo = mid + 1;
+    }
+
+    info.found = true;
+    info.tail = lo;
+    info.length = lambda;
+    return info;
+}
+
+#endif // PERIOD_H
@@ -0,0 +1,136 @@
+/**
+ * @file registry.h
+ * @brief Реестр генераторов с выбором по имени во время выполнения.
+ *
+ * Генераторы скрываются за интерфейсом BlockGenerator с одним виртуальным
+ * вызовом на блок fill(out, n), поэтому стоимость косвенного вызова
+ * распределяется на тысячи сгенерированных значений.
+ */
+
+#ifndef REGISTRY_H
+#define REGISTRY_H
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+
+#include "checkpoint.h"
+#include "generators.h"
+#include "simd_generators.h"
+
+/**
+ * @brief Абстрактный генератор с блочным интерфейсом.
+ */
+struct BlockGenerator : BlockApi<BlockGenerator> {
+    virtual ~BlockGenerator() = default;
+
+    /**
+     * @brief Заполнение буфера очередными значениями последовательности.
+     * @param out Указатель на буфер для записи.
+     * @param n Количество генерируемых значений.
+     */
+    virtual void fill(uint32_t *out, size_t n) = 0;
+
+    /// Размер сохранённого состояния в байтах.
+    virtual size_t state_size() const = 0;
+
+    /**
+     * @brief Запись состояния генератора (см. checkpoint.h).
+     * @param out Буфер размером state_size().
+     */
+    virtual void save_state(void *out) const = 0;
+
+    /**
+     * @brief Восстановление состояния, записанного save_state() генератора того же типа.
+     * @param in Буфер размером state_size().
+     */
+    virtual void load_state(const void *in) = 0;
+
+    /**
+     * @brief Генерация одного значения (через fill, медленный путь).
+     * @return Следующее значение в последовательности.
+     */
+    uint32_t next() {
+        uint32_t x;
+        fill(&x, 1);
+        return x;
+    }
+};
+
+/**
+ * @brief Обёртка конкретного генератора в BlockGenerator.
+ * @tparam G Тип генератора, удовлетворяющий RandomGenerator и Checkpointable.
+ */
+template <RandomGenerator G>
+struct BlockGeneratorImpl final : BlockGenerator {
+    static_assert(Checkpointable<G>, "registered generators must support checkpoints");
+
+    G gen; ///< Обёрнутый генератор.
+
+    explicit BlockGeneratorImpl(const G &g) : gen(g) {}
+
+    void fill(uint32_t *out, size_t n) override { gen.fill(out, n); }
+
+    size_t state_size() const override { return ::state_size<G>(); }
+
+    void save_state(void *out) const override { ::save_state(gen, out); }
+
+    void load_state(const void *in) override { ::load_state(gen, in); }
+};
+
+/**
+ * @brief Запись реестра: имя, зерно по умолчанию и фабрика.
+ */
+struct GeneratorEntry {
+    const char *name;                                        ///< Имя генератора.
+    uint64_t default_seed;                                   ///< Зерно по умолчанию.
+    std::unique_ptr<BlockGenerator> (*create)(uint64_t seed); ///< Создание генератора с заданным зерном.
+};
+
+/**
+ * @brief Фабрика обёрнутого генератора: G конструируется из зерна.
+ */
+template <RandomGenerator G, class Seed>
+std::unique_ptr<BlockGenerator> make_block_generator(uint64_t seed) {
+    return std::make_unique<BlockGeneratorImpl<G>>(G(Seed(seed)));
+}
+
+/// Таблица зарегистрированных генераторов.
+inline const GeneratorEntry generator_registry[] = {
+    {"LCG", 1234, make_block_generator<LCG<>, uint32_t>},
+    {"XORShift", 9876, make_block_generator<XORShift32, uint32_t>},
+    {"XORShift256", 9876, make_block_generator<XORShift32Sliced, uint32_t>},
+    {"MWC", 13579, make_block_generator<MWC, uint64_t>},
+    {"PCG32", 1234, make_block_generator<PCG32, uint64_t>},
+    {"PCG32x8", 1234, make_block_generator<PCG32x8, uint64_t>},
+    {"xoshiro128", 1234, make_block_generator<Xoshiro128StarStar, uint64_t>},
+    {"xoshiro256", 1234, make_block_generator<Xoshiro256StarStar, uint64_t>},
+    {"XORShift64*", 88172645463325252ull, make_block_generator<XORShift64Star, uint64_t>},
+    {"MWC64X", 0x853c49e6748fea9bull, make_block_generator<MWC64X, uint64_t>},
+    {"LCG64", 1234, make_block_generator<LCG64, uint64_t>},
+    {"xoshiro128x8", 1234, make_block_generator<Xoshiro128x8, uint64_t>},
+    {"xoshiro256x4", 1234, make_block_generator<Xoshiro256x4, uint64_t>},
+    {"Philox4x32", 1234, make_block_generator<Philox4x32, uint64_t>},
+    {"ChaCha8", 1234, make_block_generator<ChaCha8, uint64_t>},
+    {"ChaCha12", 1234, make_block_generator<ChaCha12, uint64_t>},
+    {"ChaCha20", 1234, make_block_generator<ChaCha20, uint64_t>},
+    {"SFMT19937", 1234, make_block_generator<SFMT19937, uint32_t>},
+    {"minstd_rand", 1234, make_block_generator<StdEngine<std::minstd_rand>, uint32_t>},
+    {"mt19937", 1234, make_block_generator<StdEngine<std::mt19937>, uint32_t>},
+    {"ranlux24", 1234, make_block_generator<StdEngine<std::ranlux24>, uint32_t>},
+    {"knuth_b", 1234, make_block_generator<StdEngine<std::knuth_b>, uint32_t>},
+};
+
+/**
+ * @brief Поиск генератора в реестре по имени.
+ * @param name Имя генератора.
+ * @return Указатель на запись реестра или nullptr, если имя не найдено.
+ */
+inline const GeneratorEntry *find_generator(const char *name) {
+    for (const GeneratorEntry &e : generator_registry)
+        if (strcmp(e.name, name) == 0) return &e;
+    return nullptr;
+}
+
+#endif // REGISTRY_H
@@ -0,0 +1,702 @@
+/**
+ * @file simd_generators.h
+ * @brief Многопоточные (по дорожкам SIMD-регистра) варианты генераторов из generators.h.
+ *
+ * Каждый генератор здесь хранит L независимых состояний и продвигает их все
+ * одной векторной инструкцией. Векторные ветки включаются при наличии
+ * __AVX2__ / __AVX512F__, иначе используется скалярный цикл по дорожкам.
+ */
+
+#ifndef SIMD_GENERATORS_H
+#define SIMD_GENERATORS_H
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+#include "generators.h"
+
+/**
+ * @brief Перемешивание 32-битного числа (финализатор MurmurHash3).
+ *
+ * Используется для получения начальных состояний дорожек из одного зерна.
+ */
+inline uint32_t mix32(uint32_t x) {
+    x ^= x >> 16; x *= 0x85ebca6bu;
+    x ^= x >> 13; x *= 0xc2b2ae35u;
+    x ^= x >> 16;
+    return x;
+}
+
+/**
+ * @brief Метка конструктора, принимающего состояния дорожек без изменений.
+ */
+struct RawState {};
+
+/// Значение метки RawState.
+inline constexpr RawState raw_state{};
+
+/**
+ * @brief Общие методы заполнения буфера для генераторов с L потоками.
+ *
+ * Наследник (CRTP) должен предоставить метод step(uint32_t *out), который
+ * продвигает все потоки на один шаг и записывает L значений в out.
+ * Значения неполного последнего шага сохраняются и выдаются следующими
+ * вызовами next() или fill(), так что чередующийся поток не теряет значений.
+ * Производные операции (next64(), fill64() и др.) наследуются от BlockApi.
+ * @tparam Derived Тип генератора-наследника.
+ * @tparam L Количество потоков.
+ */
+template <class Derived, size_t L>
+struct LaneEngine : BlockApi<Derived> {
+    static constexpr size_t lanes = L; ///< Количество потоков.
+    alignas(64) uint32_t pending[L];   ///< Значения последнего шага, ещё не выданные.
+    size_t pending_pos = L;            ///< Индекс первого невыданного значения в pending.
+
+    /**
+     * @brief Следующее значение чередующегося потока (out[k * L + j] в терминах fill()).
+     * @return Следующее значение в последовательности.
+     */
+    inline uint32_t next() {
+        if (pending_pos == L) {
+            static_cast<Derived *>(this)->step(pending);
+            pending_pos = 0;
+        }
+        return pending[pending_pos++];
+    }
+
+    /**
+     * @brief Заполнение буфера с чередованием потоков.
+     *
+     * out[k * L + j] — k-е значение потока j. Результат совпадает с n вызовами next().
+     * @param out Указатель на буфер для записи.
+     * @param n Количество генерируемых значений.
+     */
+    inline void fill(uint32_t *out, size_t n) {
+        size_t i = 0;
+        for (; i < n && pending_pos < L; ++i) out[i] = pending[pending_pos++];
+        for (; i + L <= n; i += L) static_cast<Derived *>(this)->step(out + i);
+        if (i < n) {
+            static_cast<Derived *>(this)->step(pending);
+            pending_pos = n - i;
+            memcpy(out + i, pending, pending_pos * sizeof(uint32_t));
+        }
+    }
+
+    /**
+     * @brief Заполнение буфера по потокам (без чередования).
+     *
+     * out[j * per_stream + k] — k-е значение потока j. Значения генерируются
+     * блоками по 8 шагов и транспонируются при записи. Невыданные значения
+     * чередующегося потока (pending) отбрасываются.
+     * @param out Указатель на буфер размером L * per_stream.
+     * @param per_stream Количество значений на каждый поток.
+     */
+    inline void fill_streams(uint32_t *out, size_t per_stream) {
+        constexpr size_t K = 8;
+        pending_pos = L;
+        alignas(64) uint32_t tmp[K][L];
+        for (size_t base = 0; base < per_stream; base += K) {
+            size_t m = per_stream - base < K ? per_stream - base : K;
+            for (size_t k = 0; k < m; ++k) static_cast<Derived *>(this)->step(tmp[k]);
+            for (size_t j = 0; j < L; ++j)
+                for (size_t k = 0; k < m; ++k)
+                    out[j * per_stream + base + k] = tmp[k][j];
+        }
+    }
+};
+
+/**
+ * @brief L независимых генераторов LCG<> (общие a и c), продвигаемых параллельно.
+ *
+ * Дорожка j ведёт собственную последовательность LCG<> из state[j].
+ * @tparam L Количество дорожек (8 для AVX2, 16 для AVX-512).
+ */
+template <size_t L>
+struct LCGLanes : LaneEngine<LCGLanes<L>, L> {
+    alignas(64) uint32_t state[L]; ///< Состояния потоков.
+
+    /**
+     * @brief Конструктор из массива начальных состояний.
+     * @param seeds L начальных значений.
+     */
+    explicit LCGLanes(const uint32_t *seeds) {
+        for (size_t j = 0; j < L; ++j) state[j] = seeds[j];
+    }
+
+    /**
+     * @brief Конструктор из одного зерна; состояния дорожек получаются перемешиванием.
+     * @param s Начальное значение.
+     */
+    explicit LCGLanes(uint32_t s = 1u) {
+        for (size_t j = 0; j < L; ++j) state[j] = mix32(s + uint32_t(j) * 0x9e3779b9u);
+    }
+
+    /**
+     * @brief Один шаг всех потоков; результат записывается в out[0..L).
+     */
+    inline void step(uint32_t *out) {
+#if defined(__AVX512F__)
+        if constexpr (L % 16 == 0) {
+            const __m512i va = _mm512_set1_epi32(int(LCG<>::a)), vc = _mm512_set1_epi32(int(LCG<>::c));
+            for (size_t j = 0; j < L; j += 16) {
+                __m512i x = _mm512_load_si512((const void *)(state + j));
+                x = _mm512_add_epi32(_mm512_mullo_epi32(x, va), vc);
+                _mm512_store_si512((void *)(state + j), x);
+                _mm512_storeu_si512((void *)(out + j), x);
+            }
+            return;
+        }
+#endif
+#if defined(__AVX2__)
+        if constexpr (L % 8 == 0) {
+            const __m256i va = _mm256_set1_epi32(int(LCG<>::a)), vc = _mm256_set1_epi32(int(LCG<>::c));
+            for (size_t j = 0; j < L; j += 8) {
+                __m256i x = _mm256_load_si256((const __m256i *)(state + j));
+                x = _mm256_add_epi32(_mm256_mullo_epi32(x, va), vc);
+                _mm256_store_si256((__m256i *)(state + j), x);
+                _mm256_storeu_si256((__m256i *)(out + j), x);
+            }
+            return;
+        }
+#endif
+        for (size_t j = 0; j < L; ++j) out[j] = state[j] = LCG<>::a * state[j] + LCG<>::c;
+    }
+};
+
+using LCGx8 = LCGLanes<8>;   ///< 8 потоков (AVX2).
+using LCGx16 = LCGLanes<16>; ///< 16 потоков (AVX-512).
+
+/**
+ * @brief L независимых генераторов XORShift32, продвигаемых параллельно.
+ *
+ * Дорожка j ведёт собственную последовательность XORShift32 из state[j].
+ * @tparam L Количество дорожек (8 для AVX2, 16 для AVX-512).
+ */
+template <size_t L>
+struct XORShift32Lanes : LaneEngine<XORShift32Lanes<L>, L> {
+    alignas(64) uint32_t state[L]; ///< Состояния потоков.
+
+    /**
+     * @brief Конструктор из массива начальных состояний.
+     * @param seeds L ненулевых начальных значений.
+     */
+    explicit XORShift32Lanes(const uint32_t *seeds) {
+        for (size_t j = 0; j < L; ++j) state[j] = seeds[j] ? seeds[j] : 2463534242u;
+    }
+
+    /**
+     * @brief Конструктор из состояний дорожек, которые используются без замены.
+     *
+     * Нулевое состояние сохраняется: дорожка с ним выдаёт только нули.
+     * @param states L начальных состояний.
+     */
+    XORShift32Lanes(RawState, const uint32_t *states) {
+        memcpy(state, states, sizeof(state));
+    }
+
+    /**
+     * @brief Конструктор из одного зерна; состояния дорожек получаются перемешиванием.
+     * @param s Начальное значение.
+     */
+    explicit XORShift32Lanes(uint32_t s = 2463534242u) {
+        for (size_t j = 0; j < L; ++j) {
+            uint32_t x = mix32(s + uint32_t(j) * 0x9e3779b9u);
+            state[j] = x ? x : 2463534242u;
+        }
+    }
+
+    /**
+     * @brief Один шаг всех потоков; результат записывается в out[0..L).
+     */
+    inline void step(uint32_t *out) {
+#if defined(__AVX512F__)
+        if constexpr (L == 16) {
+            __m512i x = _mm512_load_si512((const void *)state);
+            x = _mm512_xor_si512(x, _mm512_slli_epi32(x, 13));
+            x = _mm512_xor_si512(x, _mm512_srli_epi32(x, 17));
+            x = _mm512_xor_si512(x, _mm512_slli_epi32(x, 5));
+            _mm512_store_si512((void *)state, x);
+            _mm512_storeu_si512((void *)out, x);
+            return;
+        }
+#endif
+#if defined(__AVX2__)
+        if constexpr (L % 8 == 0) {
+            for (size_t j = 0; j < L; j += 8) {
+                __m256i x = _mm256_load_si256((const __m256i *)(state + j));
+                x = _mm256_xor_si256(x, _mm256_slli_epi32(x, 13));
+                x = _mm256_xor_si256(x, _mm256_srli_epi32(x, 17));
+                x = _mm256_xor_si256(x, _mm256_slli_epi32(x, 5));
+                _mm256_store_si256((__m256i *)(state + j), x);
+                _mm256_storeu_si256((__m256i *)(out + j), x);
+            }
+            return;
+        }
+#endif
+        for (size_t j = 0; j < L; ++j) {
+            uint32_t x = state[j];
+            x ^= x << 13;
+            x ^= x >> 17;
+            x ^= x << 5;
+            out[j] = state[j] = x;
+        }
+    }
+};
+
+using XORShift32x8 = XORShift32Lanes<8>;   ///< 8 потоков (AVX2).
+using XORShift32x16 = XORShift32Lanes<16>; ///< 16 потоков (AVX-512).
+
+/**
+ * @brief L независимых генераторов MWC с общим множителем a = MWC::a.
+ *
+ * Пара (перенос, состояние) каждого потока хранится в одном 64-битном слове
+ * p = carry * 2^32 + state, так что шаг p = a * (p mod 2^32) + p / 2^32
+ * выполняется одной инструкцией умножения 32x32->64 (vpmuludq) на дорожку.
+ * @tparam L Количество потоков (4 для AVX2, 8 для AVX-512).
+ */
+template <size_t L>
+struct MWCLanes : LaneEngine<MWCLanes<L>, L> {
+    alignas(64) uint64_t state[L]; ///< Состояния потоков в виде carry * 2^32 + state.
+
+    /**
+     * @brief Конструктор из массива начальных значений в формате MWC(uint64_t).
+     * @param seeds L начальных значений (старшие 32 бита — перенос, младшие — состояние).
+     */
+    explicit MWCLanes(const uint64_t *seeds) {
+        for (size_t j = 0; j < L; ++j) state[j] = seeds[j];
+    }
+
+    /**
+     * @brief Конструктор из одного зерна; состояния дорожек получаются перемешиванием.
+     *
+     * Перенос каждой дорожки берётся меньше a, а пара (0, 0) исключается.
+     * @param s Начальное значение.
+     */
+    explicit MWCLanes(uint64_t s = 88172645463325252ull) {
+        for (size_t j = 0; j < L; ++j) {
+            uint32_t lo = mix32(uint32_t(s) + uint32_t(j) * 0x9e3779b9u);
+            uint32_t hi = mix32(uint32_t(s >> 32) ^ lo) % MWC::a;
+            if ((lo | hi) == 0) lo = 1u;
+            state[j] = (uint64_t(hi) << 32) | lo;
+        }
+    }
+
+    /**
+     * @brief Один шаг всех потоков; младшие 32 бита записываются в out[0..L).
+     */
+    inline void step(uint32_t *out) {
+#if defined(__AVX512F__)
+        if constexpr (L % 8 == 0) {
+            const __m512i va = _mm512_set1_epi64(MWC::a);
+            for (size_t j = 0; j < L; j += 8) {
+                __m512i p = _mm512_load_si512((const void *)(state + j));
+                p = _mm512_add_epi64(_mm512_mul_epu32(p, va), _mm512_srli_epi64(p, 32));
+                _mm512_store_si512((void *)(state + j), p);
+                _mm256_storeu_si256((__m256i *)(out + j), _mm512_cvtepi64_epi32(p));
+            }
+            return;
+        }
+#endif
+#if defined(__AVX2__)
+        if constexpr (L % 4 == 0) {
+            const __m256i va = _mm256_set1_epi64x(MWC::a);
+            const __m256i lo = _mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6);
+            for (size_t j = 0; j < L; j += 4) {
+                __m256i p = _mm256_load_si256((const __m256i *)(state + j));
+                p = _mm256_add_epi64(_mm256_mul_epu32(p, va), _mm256_srli_epi64(p, 32));
+                _mm256_store_si256((__m256i *)(state + j), p);
+                _mm_storeu_si128((__m128i *)(out + j),
+                                 _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(p, lo)));
+            }
+            return;
+        }
+#endif
+        for (size_t j = 0; j < L; ++j) {
+            uint64_t p = state[j];
+            p = uint64_t(MWC::a) * uint32_t(p) + (p >> 32);
+            state[j] = p;
+            out[j] = uint32_t(p);
+        }
+    }
+};
+
+using MWCx4 = MWCLanes<4>; ///< 4 потока (AVX2).
+using MWCx8 = MWCLanes<8>; ///< 8 потоков (AVX-512).
+
+/**
+ * @brief L независимых потоков PCG32, продвигаемых параллельно.
+ *
+ * Дорожка j — генератор PCG32(seed, stream + j): у всех дорожек общее
+ * начальное значение и разные прибавки, т.е. разные потоки PCG.
+ * На AVX-512 (DQ) используется нативное 64-битное умножение, на AVX2 оно
+ * собирается из трёх умножений 32x32->64.
+ * @tparam L Количество потоков (кратно 4 для AVX2, 8 для AVX-512).
+ */
+template <size_t L>
+struct PCG32Lanes : LaneEngine<PCG32Lanes<L>, L> {
+    alignas(64) uint64_t state[L]; ///< Состояния потоков.
+    alignas(64) uint64_t inc[L];   ///< Прибавки потоков.
+
+    /**
+     * @brief Конструктор: дорожка j повторяет PCG32(s, stream + j).
+     * @param s Начальное значение.
+     * @param stream Номер первого потока.
+     */
+    explicit PCG32Lanes(uint64_t s = 0x853c49e6748fea9bull, uint64_t stream = 0) {
+        for (size_t j = 0; j < L; ++j) {
+            PCG32 g(s, stream + j);
+            state[j] = g.state;
+            inc[j] = g.inc;
+        }
+    }
+
+    /**
+     * @brief Один шаг всех потоков; результат записывается в out[0..L).
+     */
+    inline void step(uint32_t *out) {
+#if defined(__AVX512F__) && defined(__AVX512DQ__)
+        if constexpr (L % 8 == 0) {
+            const __m512i va = _mm512_set1_epi64((long long)PCG32::a);
+            for (size_t j = 0; j < L; j += 8) {
+                __m512i old = _mm512_load_si512((const void *)(state + j));
+                __m512i c = _mm512_load_si512((const void *)(inc + j));
+                _mm512_store_si512((void *)(state + j), _mm512_add_epi64(_mm512_mullo_epi64(old, va), c));
+                __m512i xs = _mm512_srli_epi64(_mm512_xor_si512(_mm512_srli_epi64(old, 18), old), 27);
+                __m512i rot = _mm512_srli_epi64(old, 59);
+                _mm256_storeu_si256((__m256i *)(out + j), _mm512_cvtepi64_epi32(_mm512_rorv_epi32(xs, rot)));
+            }
+            return;
+        }
+#endif
+#if defined(__AVX2__)
+        if constexpr (L % 4 == 0) {
+            const __m256i alo = _mm256_set1_epi64x((long long)(PCG32::a & 0xFFFFFFFFu));
+            const __m256i ahi = _mm256_set1_epi64x((long long)(PCG32::a >> 32));
+            const __m256i lo = _mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6);
+            const __m256i n32 = _mm256_set1_epi32(32);
+            for (size_t j = 0; j < L; j += 4) {
+                __m256i old = _mm256_load_si256((const __m256i *)(state + j));
+                __m256i c = _mm256_load_si256((const __m256i *)(inc + j));
+                // Младшие 64 бита произведения old * a из трёх умножений 32x32->64.
+                __m256i cross = _mm256_add_epi64(_mm256_mul_epu32(_mm256_srli_epi64(old, 32), alo),
+                                                 _mm256_mul_epu32(old, ahi));
+                __m256i prod = _mm256_add_epi64(_mm256_mul_epu32(old, alo), _mm256_slli_epi64(cross, 32));
+                _mm256_store_si256((__m256i *)(state + j), _mm256_add_epi64(prod, c));
+                __m256i xs = _mm256_srli_epi64(_mm256_xor_si256(_mm256_srli_epi64(old, 18), old), 27);
+                __m256i rot = _mm256_srli_epi64(old, 59);
+                // Сдвиг на 32 и более даёт 0, поэтому при rot = 0 результат равен xs.
+                __m256i r = _mm256_or_si256(_mm256_srlv_epi32(xs, rot),
+                                            _mm256_sllv_epi32(xs, _mm256_sub_epi32(n32, rot)));
+                _mm_storeu_si128((__m128i *)(out + j),
+                                 _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(r, lo)));
+            }
+            return;
+        }
+#endif
+        for (size_t j = 0; j < L; ++j) {
+            uint64_t old = state[j];
+            state[j] = PCG32::a * old + inc[j];
+            out[j] = PCG32::output(old);
+        }
+    }
+};
+
+using PCG32x4 = PCG32Lanes<4>; ///< 4 потока (AVX2).
+using PCG32x8 = PCG32Lanes<8>; ///< 8 потоков (AVX-512).
+
+/**
+ * @brief L подпоследовательностей xoshiro128**, продвигаемых параллельно.
+ *
+ * Дорожка j начинается с состояния Xoshiro128StarStar(seed), сдвинутого
+ * j вызовами jump(), т.е. на j * 2^64 шагов, поэтому дорожки не пересекаются.
+ * Состояние хранится по словам (структура массивов): s[k][j] — слово k дорожки j.
+ * @tparam L Количество потоков (8 для AVX2, 16 для AVX-512).
+ */
+template <size_t L>
+struct Xoshiro128Lanes : LaneEngine<Xoshiro128Lanes<L>, L> {
+    alignas(64) uint32_t s[4][L]; ///< Состояния потоков.
+
+    /**
+     * @brief Конструктор: дорожки — последовательные прыжки от Xoshiro128StarStar(seed).
+     * @param seed Начальное значение.
+     */
+    explicit Xoshiro128Lanes(uint64_t seed = 1u) {
+        Xoshiro128StarStar g(seed);
+        for (size_t j = 0; j < L; ++j) {
+            for (int k = 0; k < 4; ++k) s[k][j] = g.s[k];
+            g.jump();
+        }
+    }
+
+    /**
+     * @brief Один шаг всех потоков; результат записывается в out[0..L).
+     */
+    inline void step(uint32_t *out) {
+#if defined(__AVX512F__)
+        if constexpr (L % 16 == 0) {
+            for (size_t j = 0; j < L; j += 16) {
+                __m512i s0 = _mm512_load_si512((const void *)(s[0] + j));
+                __m512i s1 = _mm512_load_si512((const void *)(s[1] + j));
+                __m512i s2 = _mm512_load_si512((const void *)(s[2] + j));
+                __m512i s3 = _mm512_load_si512((const void *)(s[3] + j));
+                __m512i r = _mm512_rol_epi32(_mm512_add_epi32(_mm512_slli_epi32(s1, 2), s1), 7);
+                r = _mm512_add_epi32(_mm512_slli_epi32(r, 3), r);
+                __m512i t = _mm512_slli_epi32(s1, 9);
+                s2 = _mm512_xor_si512(s2, s0);
+                s3 = _mm512_xor_si512(s3, s1);
+                s1 = _mm512_xor_si512(s1, s2);
+                s0 = _mm512_xor_si512(s0, s3);
+                s2 = _mm512_xor_si512(s2, t);
+                s3 = _mm512_rol_epi32(s3, 11);
+                _mm512_store_si512((void *)(s[0] + j), s0);
+                _mm512_store_si512((void *)(s[1] + j), s1);
+                _mm512_store_si512((void *)(s[2] + j), s2);
+                _mm512_store_si512((void *)(s[3] + j), s3);
+                _mm512_storeu_si512((void *)(out + j), r);
+            }
+            return;
+        }
+#endif
+#if defined(__AVX2__)
+        if constexpr (L % 8 == 0) {
+            for (size_t j = 0; j < L; j += 8) {
+                __m256i s0 = _mm256_load_si256((const __m256i *)(s[0] + j));
+                __m256i s1 = _mm256_load_si256((const __m256i *)(s[1] + j));
+                __m256i s2 = _mm256_load_si256((const __m256i *)(s[2] + j));
+                __m256i s3 = _mm256_load_si256((const __m256i *)(s[3] + j));
+                // rotl(s1 * 5, 7) * 9; умножения на 5 и 9 — сдвиг и сложение.
+                __m256i r = _mm256_add_epi32(_mm256_slli_epi32(s1, 2), s1);
+                r = _mm256_or_si256(_mm256_slli_epi32(r, 7), _mm256_srli_epi32(r, 25));
+                r = _mm256_add_epi32(_mm256_slli_epi32(r, 3), r);
+                __m256i t = _mm256_slli_epi32(s1, 9);
+                s2 = _mm256_xor_si256(s2, s0);
+                s3 = _mm256_xor_si256(s3, s1);
+                s1 = _mm256_xor_si256(s1, s2);
+                s0 = _mm256_xor_si256(s0, s3);
+                s2 = _mm256_xor_si256(s2, t);
+                s3 = _mm256_or_si256(_mm256_slli_epi32(s3, 11), _mm256_srli_epi32(s3, 21));
+                _mm256_store_si256((__m256i *)(s[0] + j), s0);
+                _mm256_store_si256((__m256i *)(s[1] + j), s1);
+                _mm256_store_si256((__m256i *)(s[2] + j), s2);
+                _mm256_store_si256((__m256i *)(s[3] + j), s3);
+                _mm256_storeu_si256((__m256i *)(out + j), r);
+            }
+            return;
+        }
+#endif
+        for (size_t j = 0; j < L; ++j) {
+            out[j] = Xoshiro128StarStar::rotl(s[1][j] * 5u, 7) * 9u;
+            const uint32_t t = s[1][j] << 9;
+            s[2][j] ^= s[0][j];
+            s[3][j] ^= s[1][j];
+            s[1][j] ^= s[2][j];
+            s[0][j] ^= s[3][j];
+            s[2][j] ^= t;
+            s[3][j] = Xoshiro128StarStar::rotl(s[3][j], 11);
+        }
+    }
+};
+
+using Xoshiro128x8 = Xoshiro128Lanes<8>;   ///< 8 потоков (AVX2).
+using Xoshiro128x16 = Xoshiro128Lanes<16>; ///< 16 потоков (AVX-512).
+
+/**
+ * @brief L подпоследовательностей xoshiro256**, продвигаемых параллельно.
+ *
+ * Дорожка j начинается с Xoshiro256StarStar(seed), сдвинутого на j * 2^128
+ * шагов вызовами jump(). Каждая дорожка выдаёт старшие 32 бита своего
+ * 64-битного значения, как Xoshiro256StarStar::next().
+ * @tparam L Количество потоков (4 для AVX2, 8 для AVX-512).
+ */
+template <size_t L>
+struct Xoshiro256Lanes : LaneEngine<Xoshiro256Lanes<L>, L> {
+    alignas(64) uint64_t s[4][L]; ///< Состояния потоков.
+
+    /**
+     * @brief Конструктор: дорожки — последовательные прыжки от Xoshiro256StarStar(seed).
+     * @param seed Начальное значение.
+     */
+    explicit Xoshiro256Lanes(uint64_t seed = 1u) {
+        Xoshiro256StarStar g(seed);
+        for (size_t j = 0; j < L; ++j) {
+            for (int k = 0; k < 4; ++k) s[k][j] = g.s[k];
+            g.jump();
+        }
+    }
+
+    /**
+     * @brief Один шаг всех потоков; результат записывается в out[0..L).
+     */
+    inline void step(uint32_t *out) {
+#if defined(__AVX512F__)
+        if constexpr (L % 8 == 0) {
+            for (size_t j = 0; j < L; j += 8) {
+                __m512i s0 = _mm512_load_si512((const void *)(s[0] + j));
+                __m512i s1 = _mm512_load_si512((const void *)(s[1] + j));
+                __m512i s2 = _mm512_load_si512((const void *)(s[2] + j));
+                __m512i s3 = _mm512_load_si512((const void *)(s[3] + j));
+                __m512i r = _mm512_rol_epi64(_mm512_add_epi64(_mm512_slli_epi64(s1, 2), s1), 7);
+                r = _mm512_add_epi64(_mm512_slli_epi64(r, 3), r);
+                __m512i t = _mm512_slli_epi64(s1, 17);
+                s2 = _mm512_xor_si512(s2, s0);
+                s3 = _mm512_xor_si512(s3, s1);
+                s1 = _mm512_xor_si512(s1, s2);
+                s0 = _mm512_xor_si512(s0, s3);
+                s2 = _mm512_xor_si512(s2, t);
+                s3 = _mm512_rol_epi64(s3, 45);
+                _mm512_store_si512((void *)(s[0] + j), s0);
+                _mm512_store_si512((void *)(s[1] + j), s1);
+                _mm512_store_si512((void *)(s[2] + j), s2);
+                _mm512_store_si512((void *)(s[3] + j), s3);
+                _mm256_storeu_si256((__m256i *)(out + j), _mm512_cvtepi64_epi32(_mm512_srli_epi64(r, 32)));
+            }
+            return;
+        }
+#endif
+#if defined(__AVX2__)
+        if constexpr (L % 4 == 0) {
+            const __m256i hi = _mm256_setr_epi32(1, 3, 5, 7, 1, 3, 5, 7);
+            for (size_t j = 0; j < L; j += 4) {
+                __m256i s0 = _mm256_load_si256((const __m256i *)(s[0] + j));
+                __m256i s1 = _mm256_load_si256((const __m256i *)(s[1] + j));
+                __m256i s2 = _mm256_load_si256((const __m256i *)(s[2] + j));
+                __m256i s3 = _mm256_load_si256((const __m256i *)(s[3] + j));
+                __m256i r = _mm256_add_epi64(_mm256_slli_epi64(s1, 2), s1);
+                r = _mm256_or_si256(_mm256_slli_epi64(r, 7), _mm256_srli_epi64(r, 57));
+                r = _mm256_add_epi64(_mm256_slli_epi64(r, 3), r);
+                __m256i t = _mm256_slli_epi64(s1, 17);
+                s2 = _mm256_xor_si256(s2, s0);
+                s3 = _mm256_xor_si256(s3, s1);
+                s1 = _mm256_xor_si256(s1, s2);
+                s0 = _mm256_xor_si256(s0, s3);
+                s2 = _mm256_xor_si256(s2, t);
+                s3 = _mm256_or_si256(_mm256_slli_epi64(s3, 45), _mm256_srli_epi64(s3, 19));
+                _mm256_store_si256((__m256i *)(s[0] + j), s0);
+                _mm256_store_si256((__m256i *)(s[1] + j), s1);
+                _mm256_store_si256((__m256i *)(s[2] + j), s2);
+                _mm256_store_si256((__m256i *)(s[3] + j), s3);
+                _mm_storeu_si128((__m128i *)(out + j),
+                                 _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(r, hi)));
+            }
+            return;
+        }
+#endif
+        for (size_t j = 0; j < L; ++j) {
+            out[j] = uint32_t((Xoshiro256StarStar::rotl(s[1][j] * 5u, 7) * 9u) >> 32);
+            const uint64_t t = s[1][j] << 17;
+            s[2][j] ^= s[0][j];
+            s[3][j] ^= s[1][j];
+            s[1][j] ^= s[2][j];
+            s[0][j] ^= s[3][j];
+            s[2][j] ^= t;
+            s[3][j] = Xoshiro256StarStar::rotl(s[3][j], 45);
+        }
+    }
+};
+
+using Xoshiro256x4 = Xoshiro256Lanes<4>; ///< 4 потока (AVX2).
+using Xoshiro256x8 = Xoshiro256Lanes<8>; ///< 8 потоков (AVX-512).
+
+/**
+ * @brief 256 генераторов XORShift32 в побитовом (bit-sliced) представлении.
+ *
+ * Состояния хранятся транспонированными: plane[j] — 256-битная плоскость,
+ * в которой бит s равен биту j состояния потока s. Сдвиг на r бит
+ * превращается в выбор плоскости j - r, поэтому шаг всех 256 потоков —
+ * 61 исключающее ИЛИ 256-битных плоскостей без сдвигов.
+ * fill_bitplanes() выдаёт плоскости без транспонирования (для битовых
+ * тестов); step() транспонирует их в обычные 32-битные значения, так что
+ * поток s совпадает с дорожкой s генератора XORShift32Lanes<256>.
+ */
+struct XORShift32Sliced : LaneEngine<XORShift32Sliced, 256> {
+    static constexpr size_t streams = 256; ///< Количество потоков.
+    alignas(32) uint64_t plane[32][4];    ///< Битовые плоскости состояний.
+
+    /**
+     * @brief Конструктор из одного зерна (состояния потоков — как у XORShift32Lanes<256>).
+     * @param s Начальное значение.
+     */
+    explicit XORShift32Sliced(uint32_t s = 2463534242u) {
+        memset(plane, 0, sizeof(plane));
+        for (size_t k = 0; k < streams; ++k) {
+            uint32_t x = mix32(s + uint32_t(k) * 0x9e3779b9u);
+            if (!x) x = 2463534242u;
+            for (int j = 0; j < 32; ++j) plane[j][k / 64] |= uint64_t((x >> j) & 1u) << (k % 64);
+        }
+    }
+
+    /**
+     * @brief Один шаг XORShift32 всех потоков над плоскостями.
+     *
+     * x ^= x << 13: plane[j] ^= plane[j - 13] (j по убыванию);
+     * x ^= x >> 17: plane[j] ^= plane[j + 17] (j по возрастанию);
+     * x ^= x << 5:  plane[j] ^= plane[j - 5]  (j по убыванию).
+     */
+    inline void advance() {
+#if defined(__AVX2__)
+        __m256i p[32];
+        for (int j = 0; j < 32; ++j) p[j] = _mm256_load_si256((const __m256i *)plane[j]);
+        for (int j = 31; j >= 13; --j) p[j] = _mm256_xor_si256(p[j], p[j - 13]);
+        for (int j = 0; j < 15; ++j) p[j] = _mm256_xor_si256(p[j], p[j + 17]);
+        for (int j = 31; j >= 5; --j) p[j] = _mm256_xor_si256(p[j], p[j - 5]);
+        for (int j = 0; j < 32; ++j) _mm256_store_si256((__m256i *)plane[j], p[j]);
+#else
+        for (int w = 0; w < 4; ++w) {
+            for (int j = 31; j >= 13; --j) plane[j][w] ^= plane[j - 13][w];
+            for (int j = 0; j < 15; ++j) plane[j][w] ^= plane[j + 17][w];
+            for (int j = 31; j >= 5; --j) plane[j][w] ^= plane[j - 5][w];
+        }
+#endif
+    }
+
+    /**
+     * @brief Транспонирование битовой матрицы 32 x 32: бит c слова r переходит в бит r слова c.
+     */
+    static inline void transpose32(uint32_t (&a)[32]) {
+        uint32_t mask = 0x0000FFFFu;
+        for (int w = 16; w; w >>= 1, mask ^= mask << w)
+            for (int k = 0; k < 32; k = ((k | w) + 1) & ~w) {
+                uint32_t t = ((a[k] >> w) ^ a[k | w]) & mask;
+                a[k] ^= t << w;
+                a[k | w] ^= t;
+            }
+    }
+
+    /**
+     * @brief Один шаг всех потоков; значения (транспонированные плоскости) записываются в out[0..256).
+     */
+    inline void step(uint32_t *out) {
+        advance();
+        for (size_t b = 0; b < streams / 32; ++b) {
+            uint32_t a[32];
+            for (int j = 0; j < 32; ++j) a[j] = uint32_t(plane[j][b / 2] >> (32 * (b % 2)));
+            transpose32(a);
+            memcpy(out + 32 * b, a, sizeof(a));
+        }
+    }
+
+    /**
+     * @brief Заполнение буфера битовыми плоскостями без транспонирования.
+     *
+     * Плоскость бита j занимает out[j * 4 * steps .. (j + 1) * 4 * steps):
+     * слово out[j * 4 * steps + 4 * t + w] содержит бит j шага t потоков
+     * 64w .. 64w + 63. Каждая плоскость — непрерывная битовая
+     * последовательность и передаётся в битовые тесты stats.h как есть.
+     * Невыданные значения чередующегося потока (pending) отбрасываются.
+     * @param out Указатель на буфер размером 32 * 4 * steps слов.
+     * @param steps Количество шагов.
+     */
+    inline void fill_bitplanes(uint64_t *out, size_t steps) {
+        pending_pos = streams;
+        for (size_t t = 0; t < steps; ++t) {
+            advance();
+            for (int j = 0; j < 32; ++j) memcpy(out + j * 4 * steps + 4 * t, plane[j], sizeof(plane[j]));
+        }
+    }
+};
+
+#endif // SIMD_GENERATORS_H
@@ -1,9 +1,14 @@
 /**
  * @file stats.cpp
  * @brief Реализация статистических функций и тестов NIST для анализа качества генераторов случайных чисел.
+ *
+ * Тесты реализованы шаблонами по типу слова (uint32_t или uint64_t) и
+ * работают с буфером вызывающего кода напрямую, без копирования.
+ * Битовая последовательность слова читается от младшего бита к старшему.
  */
 
 #include "stats.h"
+#include <bit>
 #include <cmath>
 #include <cstdlib>
 
@@ -16,16 +21,43 @@ double mean(const uint32_t *data, int n) {
     return (double)sum / n;
 }
 
+/**
+ * @brief Вычисляет среднее значение массива 64-битных чисел (сумма в 128 битах).
+ */
+double mean(const uint64_t *data, int n) {
+    unsigned __int128 sum = 0;
+    for (int i = 0; i < n; ++i) sum += data[i];
+    return (double)sum / n;
+}
+
+/**
+ * @brief Вычисляет среднее значение массива double (четыре независимые суммы).
+ */
+double mean(const double *data, int n) {
+    double s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        s0 += data[i]; s1 += data[i + 1]; s2 += data[i + 2]; s3 += data[i + 3];
+    }
+    for (; i < n; ++i) s0 += data[i];
+    return (s0 + s1 + s2 + s3) / n;
+}
+
 /**
  * @brief Вычисляет стандартное отклонение массива.
  */
-double stdev(const uint32_t *data, int n, double m) {
+template <class Word>
+static double stdev_impl(const Word *data, int n, double m) {
     double acc = 0.0;
     for (int i = 0; i < n; ++i)
-        acc += (data[i] - m) * (data[i] - m);
+        acc += ((double)data[i] - m) * ((double)data[i] - m);
     return sqrt(acc / n);
 }
 
+double stdev(const uint32_t *data, int n, double m) { return stdev_impl(data, n, m); }
+double stdev(const uint64_t *data, int n, double m) { return stdev_impl(data, n, m); }
+double stdev(const double *data, int n, double m) { return stdev_impl(data, n, m); }
+
 /**
  * @brief Возвращает коэффициент вариации.
  */
@@ -33,6 +65,19 @@ double coeff_var(double m, double sd) {
     return m == 0.0 ? 0.0 : sd / m;
 }
 
+/**
+ * @brief Хи-квадрат по заранее посчитанным частотам корзин.
+ */
+static double chi_squared_freq(const unsigned long int *freq, int n, int bins) {
+    double expected = (double)n / bins;
+    double chi2 = 0.0;
+    for (int i = 0; i < bins; ++i) {
+        double diff = freq[i] - expected;
+        chi2 += diff * diff / expected;
+    }
+    return chi2;
+}
+
 /**
  * @brief Вычисляет критерий хи-квадрат по частотам попадания в корзины.
  */
@@ -44,13 +89,22 @@ double chi_squared(const uint32_t *data, int n, int bins, unsigned long long int
         freq[idx]++;
     }
 
-    double expected = (double)n / bins;
-    double chi2 = 0.0;
-    for (int i = 0; i < bins; ++i) {
-        double diff = freq[i] - expected;
-        chi2 += diff * diff / expected;
-    }
+    double chi2 = chi_squared_freq(freq, n, bins);
+    free(freq);
+    return chi2;
+}
+
+/**
+ * @brief Критерий хи-квадрат для 64-битных чисел на полном диапазоне [0, 2^64).
+ *
+ * Номер корзины — старшие 64 бита произведения data[i] * bins.
+ */
+double chi_squared(const uint64_t *data, int n, int bins) {
+    unsigned long int *freq = (unsigned long int *)calloc(bins, sizeof(unsigned long int));
+    for (int i = 0; i < n; ++i)
+        freq[(size_t)(((unsigned __int128)data[i] * (unsigned)bins) >> 64)]++;
 
+    double chi2 = chi_squared_freq(freq, n, bins);
     free(freq);
     return chi2;
 }
@@ -59,30 +113,41 @@ double chi_squared(const uint32_t *data, int n, int bins, unsigned long long int
  * @brief Подсчитывает количество единичных битов в 32-битном числе.
  */
 int popcount32(uint32_t x) {
-    int count = 0;
-    while (x) {
-        count += x & 1u;
-        x >>= 1;
-    }
-    return count;
+    return std::popcount(x);
+}
+
+/**
+ * @brief Подсчитывает количество единичных битов в 64-битном числе.
+ */
+int popcount64(uint64_t x) {
+    return std::popcount(x);
 }
 
+static int popcount_word(uint32_t x) { return popcount32(x); }
+static int popcount_word(uint64_t x) { return popcount64(x); }
+
 /**
  * @brief NIST Monobit Test — проверяет, приблизительно ли равное количество 0 и 1.
  */
-int nist_monobit(const uint32_t *w, size_t len) {
+template <class Word>
+static int monobit_impl(const Word *w, size_t len) {
     int64_t ones = 0;
-    for (size_t i = 0; i < len; ++i) ones += popcount32(w[i]);
-    int n = (int)len * 32;
+    for (size_t i = 0; i < len; ++i) ones += popcount_word(w[i]);
+    int n = (int)len * (int)(8 * sizeof(Word));
     double s = fabs(2.0 * ones - n) / sqrt((double)n);
     return erfc(s / sqrt(2.0)) >= 0.01;
 }
 
+int nist_monobit(const uint32_t *w, size_t len) { return monobit_impl(w, len); }
+int nist_monobit(const uint64_t *w, size_t len) { return monobit_impl(w, len); }
+
 /**
  * @brief NIST Block Frequency Test — проверяет равномерность битов в блоках размера M.
  */
-int nist_block_frequency(const uint32_t *w, size_t len, size_t M) {
-    size_t nBits = len * 32;
+template <class Word>
+static int block_frequency_impl(const Word *w, size_t len, size_t M) {
+    constexpr size_t W = 8 * sizeof(Word);
+    size_t nBits = len * W;
     size_t nBlocks = nBits / M;
     if (nBlocks < 20) return 0;
 
@@ -90,8 +155,14 @@ int nist_block_frequency(const uint32_t *w, size_t len, size_t M) {
     size_t bit = 0;
     for (size_t b = 0; b < nBlocks; ++b) {
         int ones = 0;
-        for (size_t i = 0; i < M; ++i, ++bit) {
-            ones += (w[bit / 32] >> (bit % 32)) & 1u;
+        if (M % W == 0) {
+            // Блок из целых слов: единицы считаются по словам.
+            for (size_t i = 0; i < M / W; ++i) ones += popcount_word(w[bit / W + i]);
+            bit += M;
+        } else {
+            for (size_t i = 0; i < M; ++i, ++bit) {
+                ones += (w[bit / W] >> (bit % W)) & 1u;
+            }
         }
         double pi = (double)ones / (double)M;
         chi += (pi - 0.5) * (pi - 0.5);
@@ -101,23 +172,26 @@ int nist_block_frequency(const uint32_t *w, size_t len, size_t M) {
     return p >= 0.01;
 }
 
+int nist_block_frequency(const uint32_t *w, size_t len, size_t M) { return block_frequency_impl(w, len, M); }
+int nist_block_frequency(const uint64_t *w, size_t len, size_t M) { return block_frequency_impl(w, len, M); }
+
 /**
  * @brief NIST Runs Test — проверяет, не слишком ли часто переключаются 0 и 1.
  */
-int nist_runs(const uint32_t *w, size_t len) {
-    size_t n = len * 32;
+template <class Word>
+static int runs_impl(const Word *w, size_t len) {
+    constexpr size_t W = 8 * sizeof(Word);
+    size_t n = len * W;
     int64_t ones = 0;
-    int prev = w[0] & 1;
-    ones += prev;
     int runsCnt = 1;
 
-    for (size_t i = 1; i < n; ++i) {
-        int bit = (w[i / 32] >> (i % 32)) & 1;
-        ones += bit;
-        if (bit != prev) {
-            ++runsCnt;
-            prev = bit;
-        }
+    // Серии считаются по словам: смена бита внутри слова — единица в x ^ (x >> 1)
+    // (кроме старшего разряда), смена на границе слов сравнивается отдельно.
+    const Word inner = Word(~Word(0)) >> 1;
+    for (size_t i = 0; i < len; ++i) {
+        ones += popcount_word(w[i]);
+        runsCnt += popcount_word(Word((w[i] ^ (w[i] >> 1)) & inner));
+        if (i + 1 < len) runsCnt += int((w[i] >> (W - 1)) & 1u) != int(w[i + 1] & 1u);
     }
 
     double pi = (double)ones / (double)n;
@@ -128,20 +202,58 @@ int nist_runs(const uint32_t *w, size_t len) {
     return erfc(z) >= 0.01;
 }
 
+int nist_runs(const uint32_t *w, size_t len) { return runs_impl(w, len); }
+int nist_runs(const uint64_t *w, size_t len) { return runs_impl(w, len); }
+
+/**
+ * @brief Случайное блуждание по битам одного байта (от младшего к старшему, +1 / -1).
+ */
+struct ByteWalk {
+    int8_t delta; ///< Итоговое приращение.
+    int8_t max;   ///< Максимум частичных сумм.
+    int8_t min;   ///< Минимум частичных сумм.
+};
+
+/**
+ * @brief Таблица ByteWalk для всех 256 байтов.
+ */
+struct ByteWalkTable {
+    ByteWalk entry[256];
+
+    constexpr ByteWalkTable() : entry{} {
+        for (int v = 0; v < 256; ++v) {
+            int s = 0, hi = -8, lo = 8;
+            for (int b = 0; b < 8; ++b) {
+                s += (v >> b) & 1 ? 1 : -1;
+                if (s > hi) hi = s;
+                if (s < lo) lo = s;
+            }
+            entry[v] = {int8_t(s), int8_t(hi), int8_t(lo)};
+        }
+    }
+};
+
+static constexpr ByteWalkTable byte_walk;
+
 /**
  * @brief NIST Cumulative Sums Test — проверяет смещения от нуля при суммировании битов.
  */
-int nist_cumulative_sums(const uint32_t *w, size_t len) {
+template <class Word>
+static int cumulative_sums_impl(const Word *w, size_t len) {
+    constexpr size_t W = 8 * sizeof(Word);
     int64_t s = 0;
     int64_t zmax = 0;
-    size_t n = len * 32;
+    size_t n = len * W;
 
-    for (size_t i = 0; i < n; ++i) {
-        int bit = (w[i / 32] >> (i % 32)) & 1;
-        s += bit ? 1 : -1;
-        if (s > zmax) zmax = s;
-        else if (-s > zmax) zmax = -s;
-    }
+    // Обход по байтам: для каждого байта таблица даёт приращение суммы и её
+    // максимум и минимум внутри байта, так что max |s| совпадает с побитовым обходом.
+    for (size_t i = 0; i < len; ++i)
+        for (size_t k = 0; k < W; k += 8) {
+            const ByteWalk &b = byte_walk.entry[(w[i] >> k) & 0xFFu];
+            if (s + b.max > zmax) zmax = s + b.max;
+            if (-(s + b.min) > zmax) zmax = -(s + b.min);
+            s += b.delta;
+        }
 
     if (zmax == 0) return 0;
 
@@ -158,23 +270,38 @@ int nist_cumulative_sums(const uint32_t *w, size_t len) {
     return p >= 0.01;
 }
 
+int nist_cumulative_sums(const uint32_t *w, size_t len) { return cumulative_sums_impl(w, len); }
+int nist_cumulative_sums(const uint64_t *w, size_t len) { return cumulative_sums_impl(w, len); }
+
 /**
  * @brief NIST Serial Test (2-й порядок) — проверяет частоты повторяющихся битовых шаблонов.
  */
-int nist_serial2(const uint32_t *w, size_t len) {
+template <class Word>
+static int serial2_impl(const Word *w, size_t len) {
+    constexpr size_t W = 8 * sizeof(Word);
     uint64_t c1[2] = {0, 0};   ///< Частоты одиночных битов (0, 1)
     uint64_t c2[4] = {0, 0, 0, 0}; ///< Частоты пар битов (00, 01, 10, 11)
     int first = w[0] & 1;
-    int prev = -1;
-    size_t n = len * 32;
-
-    for (size_t i = 0; i < n; ++i) {
-        int b = (w[i / 32] >> (i % 32)) & 1;
-        ++c1[b];
-        if (prev != -1) ++c2[(prev << 1) | b];
-        prev = b;
+    int last = int((w[len - 1] >> (W - 1)) & 1u);
+    size_t n = len * W;
+
+    // Пары 11 считаются по словам (x & (x >> 1) и граница слов); остальные
+    // частоты пар выводятся из числа единиц: единица, кроме последней,
+    // начинает пару 1x, а единица, кроме первой, завершает пару x1.
+    const Word inner = Word(~Word(0)) >> 1;
+    uint64_t ones = 0, c11 = 0;
+    for (size_t i = 0; i < len; ++i) {
+        ones += popcount_word(w[i]);
+        c11 += popcount_word(Word(w[i] & (w[i] >> 1) & inner));
+        if (i + 1 < len) c11 += ((w[i] >> (W - 1)) & w[i + 1] & 1u);
     }
-    ++c2[(prev << 1) | first];
+    c1[1] = ones;
+    c1[0] = n - ones;
+    c2[3] = c11;
+    c2[2] = ones - last - c11;
+    c2[1] = ones - first - c11;
+    c2[0] = (n - 1) - c2[1] - c2[2] - c2[3];
+    ++c2[(last << 1) | first];
 
     double dn = (double)(c1[0] + c1[1]);
     double psi1 = (c1[0]*c1[0] + c1[1]*c1[1]) * 2.0 / dn - dn;
@@ -186,3 +313,6 @@ int nist_serial2(const uint32_t *w, size_t len) {
     double diff = fabs(psi2 - psi1);
     return erfc(diff / (2.0 * sqrt(2.0 * dn))) >= 0.01;
 }
+
+int nist_serial2(const uint32_t *w, size_t len) { return serial2_impl(w, len); }
+int nist_serial2(const uint64_t *w, size_t len) { return serial2_impl(w, len); }
@@ -9,6 +9,10 @@
 #include <cstdint>
 #include <cstddef>
 
+// Функции, принимающие буфер, перегружены для uint32_t и uint64_t: буфер читается на месте,
+// битовые тесты обходят каждое слово от младшего бита к старшему. mean и stdev
+// принимают также буферы double (например, заполненные fill_double()).
+
 /**
  * @brief Вычисляет среднее значение выборки.
  * @param data Указатель на массив данных.
@@ -17,6 +21,22 @@
  */
 double mean(const uint32_t *data, int n);
 
+/**
+ * @brief Вычисляет среднее значение выборки 64-битных чисел.
+ * @param data Указатель на массив данных.
+ * @param n Размер выборки.
+ * @return Среднее арифметическое значений.
+ */
+double mean(const uint64_t *data, int n);
+
+/**
+ * @brief Вычисляет среднее значение выборки чисел с плавающей точкой.
+ * @param data Указатель на массив данных.
+ * @param n Размер выборки.
+ * @return Среднее арифметическое значений.
+ */
+double mean(const double *data, int n);
+
 /**
  * @brief Вычисляет стандартное отклонение выборки.
  * @param data Указатель на массив данных.
@@ -26,6 +46,24 @@ double mean(const uint32_t *data, int n);
  */
 double stdev(const uint32_t *data, int n, double m);
 
+/**
+ * @brief Вычисляет стандартное отклонение выборки 64-битных чисел.
+ * @param data Указатель на массив данных.
+ * @param n Размер выборки.
+ * @param m Среднее значение выборки.
+ * @return Стандартное отклонение.
+ */
+double stdev(const uint64_t *data, int n, double m);
+
+/**
+ * @brief Вычисляет стандартное отклонение выборки чисел с плавающей точкой.
+ * @param data Указатель на массив данных.
+ * @param n Размер выборки.
+ * @param m Среднее значение выборки.
+ * @return Стандартное отклонение.
+ */
+double stdev(const double *data, int n, double m);
+
 /**
  * @brief Вычисляет коэффициент вариации.
  * @param m Среднее значение.
@@ -36,6 +74,10 @@ double coeff_var(double m, double sd);
 
 /**
  * @brief Вычисляет значение критерия хи-квадрат для равномерности распределения.
+ *
+ * Для чисел из [0, k) (например, fill_bounded()) передаётся max_val = k;
+ * при bins = k каждое значение попадает в собственную корзину, при bins < k
+ * ожидаемые частоты корзин различаются не больше чем на bins / k.
  * @param data Указатель на массив данных.
  * @param n Размер выборки.
  * @param bins Количество интервалов (корзин).
@@ -44,6 +86,15 @@ double coeff_var(double m, double sd);
  */
 double chi_squared(const uint32_t *data, int n, int bins, unsigned long long int max_val);
 
+/**
+ * @brief Критерий хи-квадрат для 64-битных чисел, равномерных на [0, 2^64).
+ * @param data Указатель на массив данных.
+ * @param n Размер выборки.
+ * @param bins Количество интервалов (корзин).
+ * @return Значение критерия хи-квадрат.
+ */
+double chi_squared(const uint64_t *data, int n, int bins);
+
 /**
  * @brief Выполняет тест Моно-бита (NIST STS).
  * @param w Указатель на массив данных.
@@ -51,6 +102,7 @@ double chi_squared(const uint32_t *data, int n, int bins, unsigned long long int
  * @return Результат теста (1 — успешно, 0 — неуспешно).
  */
 int nist_monobit(const uint32_t *w, size_t len);
+int nist_monobit(const uint64_t *w, size_t len); ///< То же для 64-битных слов (len — число слов).
 
 /**
  * @brief Выполняет тест частот блоков (Block Frequency Test, NIST STS).
@@ -60,6 +112,7 @@ int nist_monobit(const uint32_t *w, size_t len);
  * @return Результат теста (1 — успешно, 0 — неуспешно).
  */
 int nist_block_frequency(const uint32_t *w, size_t len, size_t M);
+int nist_block_frequency(const uint64_t *w, size_t len, size_t M); ///< То же для 64-битных слов (len — число слов).
 
 /**
  * @brief Выполняет тест на количество последовательностей одинаковых битов (Runs Test, NIST STS).
@@ -68,6 +121,7 @@ int nist_block_frequency(const uint32_t *w, size_t len, size_t M);
  * @return Результат теста (1 — успешно, 0 — неуспешно).
  */
 int nist_runs(const uint32_t *w, size_t len);
+int nist_runs(const uint64_t *w, size_t len); ///< То же для 64-битных слов (len — число слов).
 
 /**
  * @brief Выполняет тест кумулятивных сумм (Cumulative Sums Test, NIST STS).
@@ -76,6 +130,7 @@ int nist_runs(const uint32_t *w, size_t len);
  * @return Результат теста (1 — успешно, 0 — неуспешно).
  */
 int nist_cumulative_sums(const uint32_t *w, size_t len);
+int nist_cumulative_sums(const uint64_t *w, size_t len); ///< То же для 64-битных слов (len — число слов).
 
 /**
  * @brief Выполняет тест на серийность второго порядка (Serial Test, NIST STS).
@@ -84,5 +139,6 @@ int nist_cumulative_sums(const uint32_t *w, size_t len);
  * @return Результат теста (1 — успешно, 0 — неуспешно).
  */
 int nist_serial2(const uint32_t *w, size_t len);
+int nist_serial2(const uint64_t *w, size_t len); ///< То же для 64-битных слов (len — число слов).
 
 #endif // STATS_H
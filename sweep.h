@@ -0,0 +1,262 @@
+/**
+ * @file sweep.h
+ * @brief Проверка качества зёрен: набор тестов stats.h по диапазону зёрен на всех ядрах.
+ *
+ * Зёрна обрабатываются группами по sweep_lanes: состояния группы хранятся
+ * в генераторе с дорожками (simd_generators.h, структура массивов) и
+ * продвигаются одной векторной инструкцией, а fill_streams() выдаёт
+ * выборку каждого зерна непрерывно. Потоки забирают участки диапазона
+ * зёрен из общего атомарного счётчика.
+ *
+ * Короткая выборка — только отбор кандидатов: при шести тестах уровня
+ * ~0.01 около 3% хороших зёрен проваливают хотя бы один тест случайно.
+ * Поэтому каждый кандидат проверяется повторно на выборке из
+ * sweep_confirm_size значений, и в список попадают только зёрна,
+ * провалившие её снова. Хорошее зерно проходит обе проверки независимо,
+ * поэтому случайных подтверждений ожидается около candidates^2 / seeds
+ * (SweepResult::expected_by_chance()); зёрна сверх этого числа — повод
+ * для разбора. Каждый поток хранит только самые слабые подтверждённые
+ * зёрна, в конце списки объединяются и ранжируются.
+ */
+
+#ifndef SWEEP_H
+#define SWEEP_H
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "period.h"
+#include "simd_generators.h"
+#include "stats.h"
+
+/// Количество зёрен, обрабатываемых одним генератором с дорожками.
+inline constexpr size_t sweep_lanes = 16;
+
+/// Длина выборки одного зерна (32-битных значений, 8192 бита).
+inline constexpr size_t sweep_sample_size = 256;
+
+/// Длина повторной выборки зерна, провалившего короткую (в 64 раза длиннее, 2^19 бит).
+inline constexpr size_t sweep_confirm_size = 1 << 14;
+
+/// Количество корзин критерия хи-квадрат (16 ожидаемых попаданий на корзину).
+inline constexpr int sweep_bins = 16;
+
+/// Порог z-оценки хи-квадрат, выше которого тест считается проваленным (p ~ 0.001).
+inline constexpr double sweep_chi2_z_limit = 3.09;
+
+/// Количество зёрен, которое поток забирает из общего счётчика за раз.
+inline constexpr uint64_t sweep_chunk = 4096;
+
+/// Названия тестов в порядке битов SeedScore::failed_mask.
+inline constexpr const char *sweep_test_names[] = {"chi2", "monobit", "block", "runs", "cusum", "serial2"};
+
+/// Количество тестов набора.
+inline constexpr int sweep_tests = 6;
+
+/**
+ * @brief Оценка одного зерна.
+ */
+struct SeedScore {
+    uint64_t seed;        ///< Зерно.
+    uint32_t failed_mask; ///< Проваленные тесты (бит i — sweep_test_names[i]).
+    int failed;           ///< Количество проваленных тестов.
+    double chi2_z;        ///< Нормированное отклонение хи-квадрат: (chi2 - df) / sqrt(2 df).
+};
+
+/**
+ * @brief Порядок ранжирования: больше проваленных тестов, затем больше chi2_z, затем меньше зерно.
+ */
+inline bool weaker_seed(const SeedScore &x, const SeedScore &y) {
+    if (x.failed != y.failed) return x.failed > y.failed;
+    if (x.chi2_z != y.chi2_z) return x.chi2_z > y.chi2_z;
+    return x.seed < y.seed;
+}
+
+/**
+ * @brief Результат проверки диапазона зёрен.
+ */
+struct SweepResult {
+    std::vector<SeedScore> weakest;           ///< Самые слабые подтверждённые зёрна по убыванию слабости.
+    uint64_t histogram[sweep_tests + 1] = {}; ///< Количество зёрен по числу проваленных тестов короткой выборки.
+    uint64_t seeds = 0;                       ///< Количество проверенных зёрен.
+    uint64_t candidates = 0;                  ///< Зёрна, провалившие короткую выборку.
+    uint64_t confirmed = 0;                   ///< Кандидаты, провалившие и повторную выборку.
+
+    /**
+     * @brief Ожидаемое число подтверждений у генератора без слабых зёрен.
+     *
+     * Доля кандидатов оценивает вероятность случайного провала; повторная
+     * выборка проваливается с той же вероятностью независимо от первой.
+     */
+    double expected_by_chance() const { return seeds ? double(candidates) * candidates / seeds : 0.0; }
+};
+
+/**
+ * @brief Прогон набора тестов на выборке одного зерна.
+ * @param seed Зерно.
+ * @param w Выборка.
+ * @param n Длина выборки (sweep_sample_size или sweep_confirm_size).
+ * @return Оценка зерна.
+ */
+inline SeedScore score_seed(uint64_t seed, const uint32_t *w, size_t n) {
+    const double df = sweep_bins - 1;
+    SeedScore s{seed, 0, 0, 0.0};
+    s.chi2_z = (chi_squared(w, n, sweep_bins, 1ull << 32) - df) / std::sqrt(2.0 * df);
+    int pass[sweep_tests] = {s.chi2_z <= sweep_chi2_z_limit,
+                             nist_monobit(w, n),
+                             nist_block_frequency(w, n, 128),
+                             nist_runs(w, n),
+                             nist_cumulative_sums(w, n),
+                             nist_serial2(w, n)};
+    for (int t = 0; t < sweep_tests; ++t)
+        if (!pass[t]) {
+            s.failed_mask |= 1u << t;
+            ++s.failed;
+        }
+    return s;
+}
+
+/**
+ * @brief Оставляет в v не больше top самых слабых зёрен, упорядоченных по weaker_seed().
+ */
+inline void keep_weakest(std::vector<SeedScore> &v, size_t top) {
+    if (v.size() > top) {
+        std::nth_element(v.begin(), v.begin() + top, v.end(), weaker_seed);
+        v.resize(top);
+    }
+    std::sort(v.begin(), v.end(), weaker_seed);
+}
+
+/**
+ * @brief Проверка зёрен first .. first + count - 1 на всех ядрах.
+ *
+ * @tparam Lanes Генератор с sweep_lanes дорожками (LaneEngine).
+ * @tparam MakeLanes Вызываемый объект: Lanes(const uint64_t *seeds) — генератор
+ *         с дорожками, инициализированными зёрнами без изменений.
+ * @param first Первое зерно.
+ * @param count Количество зёрен.
+ * @param top Длина списка слабых зёрен.
+ * @param make Создание генератора для группы зёрен.
+ * @param threads Количество потоков.
+ * @return Слабейшие подтверждённые зёрна и распределение числа проваленных тестов.
+ */
+template <class Lanes, class MakeLanes>
+SweepResult sweep_seeds(uint64_t first, uint64_t count, size_t top, MakeLanes make,
+                        unsigned threads = default_threads()) {
+    static_assert(Lanes::lanes == sweep_lanes);
+    std::atomic<uint64_t> next(0);
+    std::vector<SweepResult> partial(threads);
+    std::vector<std::thread> pool;
+
+    for (unsigned t = 0; t < threads; ++t) {
+        pool.emplace_back([&, t] {
+            SweepResult &r = partial[t];
+            alignas(64) uint32_t buf[sweep_lanes * sweep_sample_size];
+            std::vector<uint32_t> long_buf(sweep_lanes * sweep_confirm_size);
+            uint64_t seeds[sweep_lanes];
+            uint64_t pending[sweep_lanes];
+            size_t npending = 0;
+
+            // Повторная проверка накопленных кандидатов (остаток группы дополняется последним зерном).
+            auto confirm = [&] {
+                for (size_t j = npending; j < sweep_lanes; ++j) pending[j] = pending[npending - 1];
+                Lanes g = make(pending);
+                g.fill_streams(long_buf.data(), sweep_confirm_size);
+                for (size_t j = 0; j < npending; ++j) {
+                    SeedScore s = score_seed(pending[j], long_buf.data() + j * sweep_confirm_size,
+                                             sweep_confirm_size);
+                    if (s.failed) {
+                        ++r.confirmed;
+                        r.weakest.push_back(s);
+                    }
+                }
+                npending = 0;
+                if (r.weakest.size() >= 2 * top + sweep_chunk) keep_weakest(r.weakest, top);
+            };
+
+            for (;;) {
+                uint64_t begin = next.fetch_add(sweep_chunk);
+                if (begin >= count) break;
+                uint64_t end = std::min(count, begin + sweep_chunk);
+                for (uint64_t i = begin; i < end; i += sweep_lanes) {
+                    for (size_t j = 0; j < sweep_lanes; ++j) seeds[j] = first + i + j;
+                    Lanes g = make(seeds);
+                    g.fill_streams(buf, sweep_sample_size);
+                    size_t m = std::min<uint64_t>(sweep_lanes, end - i);
+                    for (size_t j = 0; j < m; ++j) {
+                        SeedScore s = score_seed(seeds[j], buf + j * sweep_sample_size, sweep_sample_size);
+                        ++r.histogram[s.failed];
+                        if (!s.failed) continue;
+                        ++r.candidates;
+                        pending[npending++] = seeds[j];
+                        if (npending == sweep_lanes) confirm();
+                    }
+                    r.seeds += m;
+                }
+            }
+            if (npending) confirm();
+            keep_weakest(r.weakest, top);
+        });
+    }
+    for (std::thread &th : pool) th.join();
+
+    SweepResult total;
+    for (SweepResult &r : partial) {
+        total.weakest.insert(total.weakest.end(), r.weakest.begin(), r.weakest.end());
+        for (int k = 0; k <= sweep_tests; ++k) total.histogram[k] += r.histogram[k];
+        total.seeds += r.seeds;
+        total.candidates += r.candidates;
+        total.confirmed += r.confirmed;
+    }
+    keep_weakest(total.weakest, top);
+    return total;
+}
+
+/**
+ * @brief Проверка зёрен генератора по имени: "LCG", "XORShift" или "MWC".
+ *
+ * Зёрна передаются генераторам без замены: для LCG и XORShift32 используются
+ * младшие 32 бита (включая нулевое состояние XORShift32), для MWC зерно —
+ * пара (перенос, состояние) в формате MWC(uint64_t).
+ *
+ * У LCG<> полный период 2^32, поэтому все зёрна лежат на одном цикле и
+ * задают не разные генераторы, а позиции старта в одной последовательности:
+ * слабое «зерно» LCG означает неудачный участок потока длиной в выборку.
+ * @param name Имя генератора.
+ * @param first Первое зерно.
+ * @param count Количество зёрен.
+ * @param top Длина списка слабых зёрен.
+ * @param out Результат.
+ * @return false, если имя генератора не поддерживается.
+ */
+inline bool sweep_generator(const char *name, uint64_t first, uint64_t count, size_t top, SweepResult &out) {
+    if (strcmp(name, "LCG") == 0) {
+        out = sweep_seeds<LCGLanes<sweep_lanes>>(first, count, top, [](const uint64_t *s) {
+            uint32_t seeds[sweep_lanes];
+            for (size_t j = 0; j < sweep_lanes; ++j) seeds[j] = uint32_t(s[j]);
+            return LCGLanes<sweep_lanes>(seeds);
+        });
+        return true;
+    }
+    if (strcmp(name, "XORShift") == 0) {
+        out = sweep_seeds<XORShift32Lanes<sweep_lanes>>(first, count, top, [](const uint64_t *s) {
+            uint32_t states[sweep_lanes];
+            for (size_t j = 0; j < sweep_lanes; ++j) states[j] = uint32_t(s[j]);
+            return XORShift32Lanes<sweep_lanes>(raw_state, states);
+        });
+        return true;
+    }
+    if (strcmp(name, "MWC") == 0) {
+        out = sweep_seeds<MWCLanes<sweep_lanes>>(first, count, top,
+                                                 [](const uint64_t *s) { return MWCLanes<sweep_lanes>(s); });
+        return true;
+    }
+    return false;
+}
+
+#endif // SWEEP_H